@@ -0,0 +1,170 @@
+#pragma once
+
+#include <bounding_volume_hierarchy/axis_aligned_bounding_box.hpp>
+#include <hittable.hpp>
+#include <line_packet.hpp>
+#include <shape.hpp>
+#include <shape/ball.hpp>
+#include <shape/ball_batch.hpp>
+
+#include <array>
+#include <memory_resource>
+#include <vector>
+
+struct bounding_volume_hierarchy_create_info
+{
+    // Nodes with at most this many primitives become leaves when splitting them does not pay off.
+    uint32_t max_leaf_size = 4;
+    // Number of buckets the centroids are sorted into along each axis when looking for a split.
+    uint32_t bin_count = 16;
+    // Relative costs of visiting a node and of testing a primitive, as used by the surface area heuristic.
+    float traversal_cost = 1.f;
+    float intersection_cost = 1.f;
+    // A refitted tree is rebuilt once its SAH cost exceeds this multiple of the cost it had when built.
+    float rebuild_cost_ratio = 1.5f;
+};
+
+// Bounding volume hierarchy flattened into a contiguous array of nodes in depth-first order.
+// The first child of an interior node directly follows it, the second one is found by its index.
+// Rays are traced through a 4-wide copy of the tree, whose nodes test all their children's
+// boxes at once with SIMD instructions. The primitives are shapes of a scene, referred to by type
+// and index into the scene's arrays, which have to outlive the tree and must not be reallocated.
+class linear_bounding_volume_hierarchy : public hittable
+{
+public:
+    // Built top-down with a binned surface area heuristic (Wald, "On fast Construction of SAH-based
+    // Bounding Volume Hierarchies", 2007). Large subtrees are built in parallel.
+    linear_bounding_volume_hierarchy(const std::pmr::vector<shape>& shapes, const std::pmr::vector<ball>& balls,
+        const min_max<float> time, const bounding_volume_hierarchy_create_info& = {});
+
+    using hittable::hit;
+
+    // The primitive of the intersection is the index of the shape that was hit in the tree's order.
+    // Only that shape computes the attributes of the hit, once traversal has finished.
+    virtual intersection_opt intersect(const struct line&, const min_max<float> t) const override;
+    virtual hit_record finalize(const struct line&, const intersection&) const override;
+    // Stops traversing at the first primitive the ray intersects.
+    virtual bool occluded(const struct line&, const min_max<float> t) const override;
+    virtual axis_aligned_bounding_box_opt bounding_box(const min_max<float> t) const override;
+
+    // Finds the closest hit of every ray in the packet. The rays are traced together, and a node is
+    // skipped for all of them at once when interval arithmetic shows that none can hit it.
+    void hit(const line_packet&, const min_max<float> t, std::array<hit_record_opt, line_packet::size>& hits) const;
+
+    // Recomputes the bounds of all nodes for the given time interval while keeping the topology,
+    // in a single bottom-up pass, e.g. after the balls of the scene have been moved. The tree stays correct but gets less efficient the further
+    // the primitives have moved since it was built.
+    void refit(const min_max<float> time);
+
+    // Expected cost of tracing a ray through the tree according to the surface area heuristic,
+    // lower is better. Only meaningful for comparing trees built over the same primitives.
+    float sah_cost() const;
+
+private:
+    struct node
+    {
+        axis_aligned_bounding_box box;
+        // Index of the first primitive for leaves, index of the second child for interior nodes.
+        uint32_t offset;
+        // Zero for interior nodes.
+        uint16_t primitive_count;
+        uint8_t split_axis;
+        uint8_t padding;
+    };
+    static_assert(sizeof(node) == 32);
+
+    inline static constexpr uint32_t width = 4;
+
+    // Up to four children with their boxes in structure of arrays layout. Unused slots have
+    // inverted boxes that no ray can hit.
+    struct alignas(16) wide_node
+    {
+        std::array<float, width> min_x;
+        std::array<float, width> min_y;
+        std::array<float, width> min_z;
+        std::array<float, width> max_x;
+        std::array<float, width> max_y;
+        std::array<float, width> max_z;
+        // Index of the first primitive for leaves, index of the child's wide node otherwise.
+        std::array<uint32_t, width> offset;
+        // Zero for interior children.
+        std::array<uint16_t, width> primitive_count;
+        // Set for leaves holding nothing but balls, which are intersected eight at a time. Such a leaf
+        // may stand for a whole subtree of the binary tree.
+        std::array<uint8_t, width> ball_leaf;
+    };
+    static_assert(sizeof(wide_node) == 128);
+
+    struct build_primitive
+    {
+        axis_aligned_bounding_box box;
+        position centroid;
+        shape object;
+    };
+
+    struct split
+    {
+        uint8_t axis;
+        uint32_t bin;
+        float cost;
+    };
+
+    struct partition
+    {
+        axis_aligned_bounding_box box;
+        bool is_leaf;
+        size_t middle;
+        uint8_t axis;
+    };
+
+    // Nodes and primitives of a subtree, indexed relative to the subtree itself.
+    struct subtree
+    {
+        std::vector<node> nodes;
+        std::vector<shape> primitives;
+    };
+
+    subtree build_in_parallel(std::vector<build_primitive>&, const size_t begin, const size_t end, const uint32_t depth) const;
+    uint32_t build(std::vector<build_primitive>&, const size_t begin, const size_t end, const uint32_t depth, subtree&) const;
+    partition partition_node(std::vector<build_primitive>&, const size_t begin, const size_t end, const uint32_t depth) const;
+    split find_split(const std::vector<build_primitive>&, const size_t begin, const size_t end,
+        const axis_aligned_bounding_box& box, const axis_aligned_bounding_box& centroid_box) const;
+
+    // Shapes are dispatched on their type, balls are the only type so far.
+    intersection_opt intersect_primitive(const uint32_t, const struct line&, const min_max<float> t) const;
+    bool primitive_occluded(const uint32_t, const struct line&, const min_max<float> t) const;
+    axis_aligned_bounding_box_opt bounding_box_of(const shape&, const min_max<float> t) const;
+
+    static uint32_t make_leaf(const std::vector<build_primitive>&, const size_t begin, const size_t end,
+        const axis_aligned_bounding_box&, subtree&);
+    static void append_subtree(subtree& destination, const subtree& source);
+
+    // Returns a bit for every child of the node that some ray of a coherent packet might hit.
+    static uint32_t packet_may_hit_children(const line_packet&, const wide_node&, const min_max<float> t);
+    // Returns a bit for every ray of the packet that hits the box, their entry distances and the nearest of those.
+    static uint32_t packet_hits_box(const line_packet&, const axis_aligned_bounding_box&, const float t_min,
+        const std::array<float, line_packet::size>& t_max, std::array<float, line_packet::size>& entry_ts, float& nearest);
+
+    // Collapses the binary tree below the given node into wide nodes, returns the index of the first one.
+    uint32_t collapse(const uint32_t binary_index);
+    // Number of primitives below the node if they are all balls and either form a single leaf or
+    // fit one batch, zero otherwise.
+    uint32_t ball_count(const uint32_t binary_index) const;
+    uint32_t first_primitive(uint32_t binary_index) const;
+
+private:
+    // Bounds the traversal stack size.
+    inline static constexpr uint32_t max_depth = 64;
+    // Subtrees with fewer primitives than this are not worth a task of their own.
+    inline static constexpr size_t parallel_build_threshold = 4096;
+
+    bounding_volume_hierarchy_create_info info;
+    uint32_t parallel_build_depth;
+
+    std::vector<node> nodes;
+    std::vector<wide_node> wide_nodes;
+    const ball* scene_balls;
+    std::vector<shape> primitives;
+    // The primitives again, with the balls among them in a layout for batched intersection.
+    ball_batch balls;
+};
\ No newline at end of file
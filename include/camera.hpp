@@ -22,7 +22,8 @@ public:
 public:
     camera(const camera_create_info&);
 
-    struct line shoot_ray_at(const float u, const float v) const;
+    // The lens sample picks the ray origin on the aperture, the time sample its moment within the shutter interval.
+    struct line shoot_ray_at(const float u, const float v, const glm::vec2& lens_sample, const float time_sample) const;
 
 private:
     position lower_left_corner;
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <bounding_volume_hierarchy/axis_aligned_bounding_box.hpp>
+#include <material.hpp>
 #include <util/pairs.hpp>
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 
@@ -11,18 +13,49 @@ struct hit_record
     float t;
     position point;
     displacement normal;
-    class material* p_material;
+    struct material material;
     std::pair<float, float> uv = { 0.f, 0.f };
 };
 
 using hit_record_opt = std::optional<hit_record>;
 
+// Where a ray hits an object, before any attributes of the hit are computed.
+struct intersection
+{
+    float t;
+    // Which primitive was hit, for objects made of several.
+    uint32_t primitive = 0;
+};
+
+using intersection_opt = std::optional<intersection>;
+
 class hittable
 {
 public:
     virtual ~hittable() = default;
-    virtual hit_record_opt hit(const struct line&, const min_max<float> t) const = 0;
+
+    // Finds the closest intersection within t and computes its hit record.
+    hit_record_opt hit(const struct line&, const min_max<float> t) const;
+
+    // Finds the closest intersection within t without computing the attributes of the hit, so that
+    // the candidates of a traversal can be compared cheaply.
+    virtual intersection_opt intersect(const struct line&, const min_max<float> t) const = 0;
+    // Computes the hit record of an intersection found by intersect.
+    virtual hit_record finalize(const struct line&, const intersection&) const = 0;
+    // Whether the ray intersects anything within t, e.g. on its way to a light. Cheaper than a closest
+    // hit, as the search can stop at the first intersection found.
+    virtual bool occluded(const struct line&, const min_max<float> t) const = 0;
+
     virtual axis_aligned_bounding_box_opt bounding_box(const min_max<float> t) const = 0;
 };
 
+inline hit_record_opt hittable::hit(const struct line& ray, const min_max<float> t) const
+{
+    if (const intersection_opt i = this->intersect(ray, t))
+    {
+        return this->finalize(ray, *i);
+    }
+    return {};
+}
+
 using unique_hittable = std::unique_ptr<hittable>;
\ No newline at end of file
@@ -1,25 +1,46 @@
 #pragma once
 
+#include <hittable.hpp>
 #include <util/colors.hpp>
+#include <util/pairs.hpp>
 #include <util/vector_types.hpp>
 
+#include <array>
+#include <cfloat>
+#include <cstdint>
 #include <optional>
 
+// A ray, with what slab tests need to know about its direction computed up front. Rays can be
+// assigned to, e.g. to reuse one for every bounce of a path, but the direction must not be changed
+// on its own, as the values derived from it would be stale.
 struct line
 {
-    const position origin;
-    const displacement direction;
-    const displacement inverse_direction;
-    const float time;
+    position origin;
+    displacement direction;
+    displacement inverse_direction;
+    // Per axis 1 if the direction is negative, making the maximum of a box the plane the ray enters through.
+    std::array<uint8_t, 3> is_negative;
+    float time;
 
     line(const position& origin, const displacement& direction, const float time = 0.f)
         : origin(origin)
         , direction(direction)
         , inverse_direction(1.f / direction)
+        , is_negative{ uint8_t(inverse_direction.x < 0.f), uint8_t(inverse_direction.y < 0.f), uint8_t(inverse_direction.z < 0.f) }
         , time(time)
     {
     }
 
+    // Hits closer to the origin than the minimum are ignored, so that rays do not hit the surface they leave.
+    inline static constexpr min_max<float> hit_interval = { 0.0001f, FLT_MAX };
+
+    // Paths are cut after this many bounces.
+    inline static constexpr int32_t max_depth = 50;
+    // From this bounce on, paths are randomly terminated with a probability based on their throughput.
+    inline static constexpr int32_t russian_roulette_depth = 5;
+
     position point_at_parameter(const float t) const;
-    color seen_color(const class scene&, const int32_t depth = 0) const;
+    color seen_color(const class scene&, class sample_stream&) const;
+    // Continues from an already known first hit of this ray within hit_interval.
+    color seen_color(const class scene&, class sample_stream&, const hit_record_opt& first_hit) const;
 };
\ No newline at end of file
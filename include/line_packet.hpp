@@ -0,0 +1,47 @@
+#pragma once
+
+#include <line.hpp>
+#include <util/pairs.hpp>
+#include <util/vector_types.hpp>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+// Up to eight rays with their origins and inverse directions in structure of arrays layout, so
+// that a box can be tested against all of them at once. Meant for coherent rays like the camera
+// rays of neighbouring pixels.
+class line_packet
+{
+public:
+    inline static constexpr uint32_t size = 8;
+
+    alignas(16) std::array<float, size> origin_x{};
+    alignas(16) std::array<float, size> origin_y{};
+    alignas(16) std::array<float, size> origin_z{};
+    alignas(16) std::array<float, size> inverse_direction_x{};
+    alignas(16) std::array<float, size> inverse_direction_y{};
+    alignas(16) std::array<float, size> inverse_direction_z{};
+
+    // Bounds of the values above over all rays.
+    min_max<position> origin_bounds;
+    min_max<displacement> inverse_direction_bounds;
+
+public:
+    // At most size rays can be added.
+    void add(const line&);
+
+    uint32_t count() const;
+    const line& operator[](const uint32_t i) const;
+
+    // Bit i is set for every ray i in the packet.
+    uint32_t active_mask() const;
+
+    // True if the directions of all rays have the same signs and no zero components. Only then
+    // can a box be culled for the whole packet with interval arithmetic.
+    bool is_coherent() const;
+
+private:
+    std::array<std::optional<line>, size> lines;
+    uint32_t line_count = 0;
+};
\ No newline at end of file
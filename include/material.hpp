@@ -1,25 +1,15 @@
 #pragma once
 
-#include <line.hpp>
-#include <util/vector_types.hpp>
+#include <util/numeric_types.hpp>
 
-#include <memory>
-#include <optional>
-
-struct scattering
+enum class material_type
 {
-    color attenuation;
-    line scattered_ray;
+    none, dielectric, diffuse_light, lambertian, metal
 };
 
-using scattering_opt = std::optional<scattering>;
-
-class material
+// Refers to a material stored in the scene's array for its type.
+struct material
 {
-public:
-    virtual ~material() = default;
-    virtual scattering_opt scatter(const line&, const struct hit_record&) const = 0;
-    virtual color emitted(const std::pair<float, float> uv, const position&) const;
-};
-
-using unique_material = std::unique_ptr<material>;
\ No newline at end of file
+    material_type type = material_type::none;
+    array_index index = 0;
+};
\ No newline at end of file
@@ -1,19 +1,18 @@
 #pragma once
 
-#include <material.hpp>
+#include <scattering.hpp>
 #include <texture.hpp>
 #include <util/colors.hpp>
 
-class dielectric : public material
+class dielectric
 {
 public:
-    dielectric(const color&, const float refractive_index);
-    dielectric(unique_texture&&, const float refractive_index);
-    virtual scattering_opt scatter(const line&, const struct hit_record&) const override;
+    dielectric(const texture& albedo, const float refractive_index);
+    scattering_opt scatter(const line&, const struct hit_record&, const color& albedo, class sample_stream&) const;
 
 public:
     float refractive_index;
-    unique_texture albedo;
+    texture albedo;
 
 private:
     static float schlick(float cosine, float refractive_index);
@@ -1,17 +1,13 @@
 #pragma once
 
-#include <material.hpp>
 #include <texture.hpp>
 
-class diffuse_light : public material
+// Emits light and does not scatter any.
+class diffuse_light
 {
 public:
-    diffuse_light(const color&);
-    diffuse_light(unique_texture&&);
+    diffuse_light(const texture& emit);
 
-    virtual scattering_opt scatter(const line&, const struct hit_record&) const override;
-    virtual color emitted(const std::pair<float, float> uv, const position&) const override;
-
-private:
-    unique_texture emit;
+    // The emitted radiance is the value of this texture at the hit.
+    texture emit;
 };
\ No newline at end of file
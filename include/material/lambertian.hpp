@@ -1,16 +1,15 @@
 #pragma once
 
-#include <material.hpp>
+#include <scattering.hpp>
 #include <texture.hpp>
 #include <util/colors.hpp>
 
-class lambertian : public material
+class lambertian
 {
 public:
-    lambertian(const color&);
-    lambertian(unique_texture&&);
-    virtual scattering_opt scatter(const line&, const struct hit_record&) const override;
+    lambertian(const texture& albedo);
+    scattering_opt scatter(const line&, const struct hit_record&, const color& albedo, class sample_stream&) const;
 
 public:
-    unique_texture albedo;
+    texture albedo;
 };
\ No newline at end of file
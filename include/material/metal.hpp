@@ -1,16 +1,16 @@
 #pragma once
 
-#include <material.hpp>
+#include <scattering.hpp>
 #include <texture.hpp>
+#include <util/colors.hpp>
 
-class metal : public material
+class metal
 {
 public:
-    metal(const color&, const float fuzz);
-    metal(unique_texture&&, const float fuzz);
-    virtual scattering_opt scatter(const line&, const struct hit_record&) const override;
+    metal(const texture& albedo, const float fuzz);
+    scattering_opt scatter(const line&, const struct hit_record&, const color& albedo, class sample_stream&) const;
 
 public:
-    unique_texture albedo;
     float fuzz;
+    texture albedo;
 };
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <util/vector_types.hpp>
+
+#include <glm/gtc/constants.hpp>
+
+#include <cmath>
+#include <utility>
+
+// Concentric mapping (Shirley & Chiu) of the unit square onto the unit disk in the XY plane.
+// Unlike rejection sampling it keeps the stratification of the input samples.
+inline static displacement sample_unit_disk(const glm::vec2& u)
+{
+    const glm::vec2 offset = { 2.f * u.x - 1.f, 2.f * u.y - 1.f };
+    if (offset.x == 0.f && offset.y == 0.f)
+    {
+        return displacement{ 0.f };
+    }
+
+    const auto [radius, theta] = glm::abs(offset.x) > glm::abs(offset.y)
+        ? std::make_pair(offset.x, glm::quarter_pi<float>() * (offset.y / offset.x))
+        : std::make_pair(offset.y, glm::half_pi<float>() - glm::quarter_pi<float>() * (offset.x / offset.y));
+    return displacement{ radius * glm::cos(theta), radius * glm::sin(theta), 0.f };
+}
+
+// Uniformly distributed point inside the unit ball.
+inline static displacement sample_unit_ball(const glm::vec2& direction_sample, const float radius_sample)
+{
+    const float z = 1.f - 2.f * direction_sample.x;
+    const float ring_radius = glm::sqrt(glm::max(0.f, 1.f - z * z));
+    const float phi = glm::two_pi<float>() * direction_sample.y;
+    return std::cbrt(radius_sample) * displacement{ ring_radius * glm::cos(phi), ring_radius * glm::sin(phi), z };
+}
\ No newline at end of file
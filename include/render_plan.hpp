@@ -1,6 +1,7 @@
 #pragma once
 
 #include <camera.hpp>
+#include <sampler.hpp>
 #include <util/sizes.hpp>
 #include <scene.hpp>
 
@@ -8,9 +9,20 @@ struct render_plan
 {
     extent_2d<uint32_t> image_size;
     camera cam;
+    // The acceleration structure of the world has to be built over this interval before rendering.
+    min_max<float> shutter;
     scene world;
 
-    static render_plan random_balls(const extent_2d<uint32_t>&);
-    static render_plan two_noise_spheres(const extent_2d<uint32_t>&);
-    static render_plan space(const extent_2d<uint32_t>&);
+    // Base seed of all random numbers used to render the plan. Together with the pixel coordinates
+    // it determines the image, independently of the thread count and of the tile order.
+    uint64_t seed = 0;
+
+    // Sample pattern used for the pixel, lens, time and scattering dimensions of every path.
+    sampler_type sampling = sampler_type::sobol;
+
+    static render_plan random_balls(const extent_2d<uint32_t>&, const uint64_t seed = 0);
+    static render_plan two_noise_spheres(const extent_2d<uint32_t>&, const uint64_t seed = 0);
+    static render_plan space(const extent_2d<uint32_t>&, const uint64_t seed = 0);
+    // Simple enough for the Vulkan renderer, which only shades lambertian materials so far.
+    static render_plan hello_ball(const extent_2d<uint32_t>&, const uint64_t seed = 0);
 };
\ No newline at end of file
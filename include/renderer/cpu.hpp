@@ -1,24 +1,122 @@
 #pragma once
 
+#include <line.hpp>
 #include <render_plan.hpp>
 #include <util/colors.hpp>
+#include <util/work_stealing_pool.hpp>
 
-#include <future>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <vector>
 
+struct render_progress
+{
+    float fraction;
+    std::chrono::steady_clock::duration elapsed;
+    std::chrono::steady_clock::duration estimated_remaining;
+};
+
+using progress_callback = std::function<void(const render_progress&)>;
+
+struct adaptive_sampling
+{
+    bool enabled = false;
+
+    // Samples every pixel gets before its error is first estimated.
+    uint32_t min_sample_count = 16;
+    // Samples added to an unconverged pixel per refinement round, at least one.
+    uint32_t batch_size = 16;
+    // A pixel is converged once the standard error of its displayed (gamma-encoded) luminance
+    // falls below this value.
+    float error_threshold = 0.01f;
+    // Samples saved on converged pixels are spent on noisy pixels of the same tile, up to this
+    // multiple of the renderer's sample count per pixel. The budget is per tile and is not moved
+    // between tiles, so the result does not depend on the order the tiles are rendered in.
+    float max_sample_factor = 4.f;
+};
+
 class cpu_renderer
 {
 public:
-    cpu_renderer(const uint32_t sample_count, const uint32_t thread_count);
+    // The worker threads are created here and reused by every render_scene call.
+    cpu_renderer(const uint32_t sample_count, const uint32_t thread_count,
+        const thread_affinity = thread_affinity::none);
+    ~cpu_renderer();
+
     std::vector<rgba> render_scene(const render_plan&);
 
+    // Renders into a caller-owned buffer of at least image_size.width * image_size.height pixels.
+    // If given, sample_counts receives the number of samples taken for every pixel.
+    void render_scene(const render_plan&, rgba* image, uint32_t* sample_counts = nullptr);
+
+    // Without adaptive sampling every pixel takes exactly the renderer's sample count.
+    void set_adaptive_sampling(const adaptive_sampling&);
+
+    // The callback is invoked from the renderer's reporter thread every interval while a frame is
+    // being rendered, and once more when it is finished. An empty callback turns reporting off.
+    // By default the progress is printed to the standard output. Not to be called during a render.
+    void set_progress_callback(progress_callback, const std::chrono::milliseconds interval = std::chrono::milliseconds{ 100 });
+
+    // Safe to call from any thread, also while render_scene is running.
+    render_progress progress() const;
+
 private:
-    std::vector<rgba> render_fragment(const render_plan*, const glm::uvec2 top_left, const glm::uvec2 bottom_right);
+    // Running mean and variance (Welford) of the samples of one pixel.
+    struct pixel_estimate
+    {
+        color sum{ 0.f };
+        float luminance_mean = 0.f;
+        float luminance_m2 = 0.f;
+        uint32_t count = 0;
+
+        void add(const color&);
+        float standard_error() const;
+    };
+
+private:
+    // Body of the reporter thread, which sleeps between frames.
+    void report();
+    static void print_progress(const render_progress&);
+
+    void render_fragment(const render_plan*, const sampler*, rgba* image, uint32_t* sample_counts,
+        const glm::uvec2 top_left, const glm::uvec2 bottom_right);
+    void render_fragment_adaptively(const render_plan*, const sampler*, rgba* image, uint32_t* sample_counts,
+        const glm::uvec2 top_left, const glm::uvec2 bottom_right);
+
+    void trace_samples(const render_plan*, const sampler*, const glm::uvec2 pixel,
+        const uint32_t first_sample, const uint32_t count, pixel_estimate&) const;
+    // Traces the same samples for a run of up to line_packet::size pixels in a row, with the camera
+    // rays of every sample as one packet. Bounces are traced one ray at a time.
+    void trace_packets(const render_plan*, const sampler*, const glm::uvec2 first_pixel, const uint32_t pixel_count,
+        const uint32_t first_sample, const uint32_t count, pixel_estimate* estimates) const;
+    static line camera_ray(const render_plan*, const glm::uvec2 pixel, sample_stream&);
+    static void store_pixel(const render_plan*, rgba* image, uint32_t* sample_counts, const glm::uvec2 pixel,
+        const pixel_estimate&);
 
 private:
+    inline static constexpr uint32_t tile_size = 32;
+
     const uint32_t sample_count;
-    const uint32_t thread_count;
 
-    float progress = 0.f;
-    mutable std::mutex progress_mtx;
+    work_stealing_pool workers;
+
+    adaptive_sampling adaptive;
+
+    progress_callback on_progress = print_progress;
+    std::chrono::milliseconds progress_interval{ 100 };
+
+    std::atomic<uint64_t> rendered_pixels = 0;
+    std::atomic<uint64_t> total_pixels = 0;
+    std::atomic<std::chrono::steady_clock::time_point> render_start;
+
+    std::mutex reporter_mtx;
+    std::condition_variable reporter_wake;
+    bool frame_running = false;
+    bool reporter_stopping = false;
+    // Started by the constructor and joined by the destructor.
+    std::thread reporter;
 };
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <util/random.hpp>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <memory>
+
+enum class sampler_type
+{
+    independent, stratified, halton, sobol
+};
+
+// Sample values are a pure function of the pixel, the sample index and the dimension, so one
+// sampler can be shared by all render threads.
+class sampler
+{
+public:
+    virtual ~sampler() = default;
+
+    // Values are in [0, 1).
+    virtual float sample_1d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const = 0;
+    virtual glm::vec2 sample_2d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const = 0;
+};
+
+using unique_sampler = std::unique_ptr<sampler>;
+
+// Decorrelates the sample sets of different pixels and dimensions.
+inline static uint64_t pixel_dimension_seed(const uint64_t seed, const glm::uvec2 pixel, const uint32_t dimension)
+{
+    return mix_seed(mix_seed(seed, (uint64_t(pixel.y) << 32u) | pixel.x), dimension);
+}
+
+// Maps the upper 24 bits of a 32-bit integer to a float in [0, 1).
+inline static float bits_to_unit_float(const uint32_t bits)
+{
+    return float(bits >> 8u) * (1.f / 16777216.f);
+}
+
+unique_sampler make_sampler(const sampler_type, const uint32_t samples_per_pixel, const uint64_t seed);
+
+// Hands out consecutive dimensions of one pixel sample in the order a path consumes them:
+// pixel position, lens, time, and then whatever the materials ask for at every bounce.
+class sample_stream
+{
+public:
+    sample_stream(const sampler&, const glm::uvec2 pixel, const uint32_t sample_index);
+
+    float next_1d();
+    glm::vec2 next_2d();
+
+private:
+    const sampler* source;
+    glm::uvec2 pixel;
+    uint32_t sample_index;
+    uint32_t dimension = 0;
+};
\ No newline at end of file
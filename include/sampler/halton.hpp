@@ -0,0 +1,29 @@
+#pragma once
+
+#include <sampler.hpp>
+#include <sampler/independent.hpp>
+
+#include <array>
+
+// Halton sequence with one prime base per dimension, decorrelated between pixels with
+// a Cranley-Patterson rotation. Dimensions past the prime table fall back to independent samples.
+class halton_sampler : public sampler
+{
+public:
+    halton_sampler(const uint64_t seed);
+
+    virtual float sample_1d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const override;
+    virtual glm::vec2 sample_2d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const override;
+
+private:
+    static float radical_inverse(const uint32_t base, uint32_t index);
+
+private:
+    inline static constexpr std::array<uint32_t, 32> primes = {
+        2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53,
+        59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131,
+    };
+
+    uint64_t seed;
+    independent_sampler fallback;
+};
\ No newline at end of file
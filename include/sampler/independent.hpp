@@ -0,0 +1,16 @@
+#pragma once
+
+#include <sampler.hpp>
+
+// Uncorrelated uniform random numbers derived by hashing the sample coordinates.
+class independent_sampler : public sampler
+{
+public:
+    independent_sampler(const uint64_t seed);
+
+    virtual float sample_1d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const override;
+    virtual glm::vec2 sample_2d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const override;
+
+private:
+    uint64_t seed;
+};
\ No newline at end of file
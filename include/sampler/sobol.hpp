@@ -0,0 +1,23 @@
+#pragma once
+
+#include <sampler.hpp>
+
+// Owen-scrambled Sobol (0,2)-sequence padded across dimensions, following Burley, "Practical
+// Hash-based Owen Scrambling", 2020. Every 2D dimension gets its own index shuffle and scramble,
+// so any number of dimensions keeps the stratification of the first two Sobol dimensions.
+class sobol_sampler : public sampler
+{
+public:
+    sobol_sampler(const uint64_t seed);
+
+    virtual float sample_1d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const override;
+    virtual glm::vec2 sample_2d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const override;
+
+private:
+    static uint32_t reverse_bits(uint32_t);
+    static uint32_t nested_uniform_scramble(const uint32_t, const uint32_t seed);
+    static uint32_t sobol_second_dimension(uint32_t index);
+
+private:
+    uint64_t seed;
+};
\ No newline at end of file
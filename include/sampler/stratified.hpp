@@ -0,0 +1,24 @@
+#pragma once
+
+#include <sampler.hpp>
+#include <sampler/independent.hpp>
+
+// Jittered sampling: every dimension is split into one stratum per sample (a grid of strata for
+// 2D dimensions) and the samples of a pixel visit the strata in a per-dimension random order.
+class stratified_sampler : public sampler
+{
+public:
+    stratified_sampler(const uint32_t samples_per_pixel, const uint64_t seed);
+
+    virtual float sample_1d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const override;
+    virtual glm::vec2 sample_2d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const override;
+
+private:
+    static uint32_t permute(uint32_t i, const uint32_t length, const uint32_t seed);
+
+private:
+    uint64_t seed;
+    uint32_t strata_count;
+    glm::uvec2 strata_grid;
+    independent_sampler jitter;
+};
\ No newline at end of file
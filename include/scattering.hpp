@@ -0,0 +1,14 @@
+#pragma once
+
+#include <line.hpp>
+#include <util/colors.hpp>
+
+#include <optional>
+
+struct scattering
+{
+    color attenuation;
+    line scattered_ray;
+};
+
+using scattering_opt = std::optional<scattering>;
\ No newline at end of file
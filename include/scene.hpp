@@ -1,39 +1,132 @@
 #pragma once
 
-#include <bounding_volume_hierarchy/axis_aligned_bounding_box.hpp>
+#include <bounding_volume_hierarchy/linear_bounding_volume_hierarchy.hpp>
 #include <hittable.hpp>
+#include <material.hpp>
+#include <material/dielectric.hpp>
+#include <material/diffuse_light.hpp>
+#include <material/lambertian.hpp>
+#include <material/metal.hpp>
+#include <scattering.hpp>
+#include <shape.hpp>
+#include <shape/ball.hpp>
+#include <texture.hpp>
+#include <texture/checker.hpp>
 #include <texture/constant.hpp>
+#include <texture/image.hpp>
+#include <texture/noise.hpp>
+#include <util/noise.hpp>
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
-#include <type_traits>
-#include <utility>
+#include <memory_resource>
 #include <vector>
 
+// Everything in a scene is plain data kept in one array per type, and refers to the rest by type
+// and index. The CPU renderer traces these arrays, the Vulkan renderer uploads them as they are.
+// The arrays, texels included, are filled by the add functions and allocated from a pool owned by
+// the scene. The storage an array gives back as it grows is reused by the others, and everything
+// is released at once with the scene.
 class scene : public hittable
 {
+private:
+    // Behind a pointer, so that the arrays of a moved scene still refer to it.
+    std::unique_ptr<std::pmr::unsynchronized_pool_resource> pool =
+        std::make_unique<std::pmr::unsynchronized_pool_resource>();
+
 public:
-    unique_texture sky;
+    // White unless set to another texture of the scene.
+    texture sky;
+
+    std::pmr::vector<shape> shapes{ this->pool.get() };
+    std::pmr::vector<ball> balls{ this->pool.get() };
+
+    std::pmr::vector<dielectric> dielectric_materials{ this->pool.get() };
+    std::pmr::vector<diffuse_light> diffuse_light_materials{ this->pool.get() };
+    std::pmr::vector<lambertian> lambertian_materials{ this->pool.get() };
+    std::pmr::vector<metal> metal_materials{ this->pool.get() };
+
+    std::pmr::vector<checker_texture> checker_textures{ this->pool.get() };
+    std::pmr::vector<constant_texture> constant_textures{ this->pool.get() };
+    std::pmr::vector<image_texture> image_textures{ this->pool.get() };
+    std::pmr::vector<noise_texture> noise_textures{ this->pool.get() };
+
+    // Referred to by image and noise textures. These are not part of the scene's bytes.
+    std::pmr::vector<image> images{ this->pool.get() };
+    std::pmr::vector<perlin> perlin_noises{ this->pool.get() };
 
 public:
-    scene(unique_texture&& sky = std::make_unique<constant_texture>(color{ 1.f }));
-
-    template<class T, typename... Args>
-    void spawn_object(Args... args)
-    {
-        static_assert(std::is_base_of_v<hittable, T>);
-
-        this->hittables.push_back(std::make_unique<T>(std::forward<Args>(args)...));
-        if (const axis_aligned_bounding_box_opt last_box =
-            this->hittables.back()->bounding_box(min_max<float>{ 0.0001f, FLT_MAX }))
-        {
-            this->box = axis_aligned_bounding_box::surrounding(this->box, *last_box);
-        }
-    }
-
-    virtual hit_record_opt hit(const struct line&, const min_max<float> t) const override;
+    scene();
+    scene(scene&&) = default;
+    // Assigning would leave the arrays of this scene behind in the pool being replaced.
+    scene& operator=(scene&&) = delete;
+
+    // Adding an object drops the acceleration structure, which has to be built or updated again
+    // before the scene is rendered. Spawning many objects in a row thus costs a single build.
+    shape add_shape(const ball&);
+
+    // Builds the bounding volume hierarchy over the objects as they are during the given time
+    // interval. Has to be called before the scene is rendered, returns how long the build took.
+    std::chrono::steady_clock::duration build_acceleration(const min_max<float> time,
+        const bounding_volume_hierarchy_create_info& = {});
+    bool is_acceleration_built() const;
+    // Expected cost of tracing a ray through the hierarchy according to the surface area heuristic,
+    // zero if none is built. Lower is better when comparing builds over the same objects.
+    float acceleration_sah_cost() const;
+
+    // Moves the acceleration structure to another time interval, e.g. the shutter interval of the
+    // next frame of an animation. The hierarchy is refitted, and only rebuilt once its quality
+    // has degraded past the rebuild_cost_ratio it was built with, or if objects were added since
+    // it was built. Returns whether it was rebuilt.
+    bool update_acceleration(const min_max<float> time);
+
+    material add_material(dielectric&&);
+    material add_material(diffuse_light&&);
+    material add_material(lambertian&&);
+    material add_material(metal&&);
+
+    // Textures made of other textures, like checkers, refer to textures added before them.
+    // Every noise texture gets a Perlin noise of its own, drawn from the random generator here.
+    texture add_texture(checker_texture&&);
+    texture add_texture(constant_texture&&);
+    texture add_texture(image_texture&&);
+    texture add_texture(noise_texture&&);
+
+    // Returns a texture showing the image, still to be added with add_texture. The texels are moved
+    // into the scene's pool.
+    image_texture add_image(image&&);
+
+    // Follows the checkers down to the texture shown at the point and evaluates it.
+    color value_at(texture, const std::pair<float, float> uv, const position&) const;
+
+    // Shade a hit with its material, found with a switch on the material's type.
+    scattering_opt scatter(const line&, const hit_record&, class sample_stream&) const;
+    color emitted(const hit_record&) const;
+
+    // The sky and the arrays from shapes to noise_textures one after another, in the std140 layout
+    // of the scene buffer of the shaders.
+    std::vector<uint8_t> to_bytes() const;
+    size_t size() const;
+
+    using hittable::hit;
+
+    // Without a built acceleration structure every shape is tested against every ray.
+    virtual intersection_opt intersect(const struct line&, const min_max<float> t) const override;
+    virtual hit_record finalize(const struct line&, const intersection&) const override;
+    virtual bool occluded(const struct line&, const min_max<float> t) const override;
     virtual axis_aligned_bounding_box_opt bounding_box(const min_max<float> t) const override;
 
+    void hit(const line_packet&, const min_max<float> t, std::array<hit_record_opt, line_packet::size>& hits) const;
+
+private:
+    intersection_opt intersect_shape(const shape&, const struct line&, const min_max<float> t) const;
+    void rebuild_acceleration();
+
 private:
-    mutable std::vector<unique_hittable> hittables;
-    axis_aligned_bounding_box box;
+    // Owned by the scene, so that every scene is traced through its own objects.
+    std::unique_ptr<linear_bounding_volume_hierarchy> bvh;
+    min_max<float> acceleration_time;
+    bounding_volume_hierarchy_create_info acceleration_info;
+    float built_sah_cost = 0.f;
 };
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <util/numeric_types.hpp>
+
+enum class shape_type
+{
+    none, ball
+};
+
+// Refers to a shape stored in the scene's array for its type. Aligned like a structure in the
+// std140 scene block of the shaders.
+struct alignas(16) shape
+{
+    shape_type type = shape_type::none;
+    array_index index = 0;
+};
\ No newline at end of file
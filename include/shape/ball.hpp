@@ -5,24 +5,32 @@
 #include <util/pairs.hpp>
 #include <util/vector_types.hpp>
 
-class ball : public hittable
+// Plain data, so that the balls of a scene can be copied to the GPU as they are. The members are
+// laid out like Ball in the std140 scene block of the shaders.
+class ball
 {
 public:
     ball() = default;
     ball(const from_to<position>& center_transition, const min_max<float> time_transition,
-        const float radius, unique_material&&);
-    ball(const position& center, const float radius, unique_material&&);
+        const float radius, const material&);
+    ball(const position& center, const float radius, const material&);
 
-    virtual hit_record_opt hit(const struct line&, const min_max<float> t) const override;
-    virtual axis_aligned_bounding_box_opt bounding_box(const min_max<float> t) const override;
+    intersection_opt intersect(const struct line&, const min_max<float> t) const;
+    hit_record finalize(const struct line&, const intersection&) const;
+    bool occluded(const struct line&, const min_max<float> t) const;
+    axis_aligned_bounding_box_opt bounding_box(const min_max<float> t) const;
     position center_at_time(const float time) const;
     std::pair<float, float> uv_at(const position&, const float time) const;
 
 private:
-    from_to<position> center_transition;
-    min_max<float> time_transition;
+    friend class ball_batch;
+
+    position center_from;
     float radius;
+    position center_to;
     float inverse_radius;
-    unique_material mat;
+    min_max<float> time_transition;
     float inverse_time_interval = 1.f;
+    // Structures start on 16 bytes in std140.
+    alignas(16) material mat;
 };
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <hittable.hpp>
+#include <util/pairs.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class ball;
+
+// Balls in structure of arrays layout, so that a ray can be intersected with eight of them at once.
+// Indices are those of the primitives in the order they were added.
+class ball_batch
+{
+public:
+    inline static constexpr uint32_t lane_count = 8;
+
+public:
+    ball_batch();
+
+    // Null adds a placeholder that no ray hits, standing for a primitive that is not a ball.
+    void push_back(const ball*);
+
+    bool is_ball(const uint32_t index) const;
+
+    // Copies the balls again from where they were added from, after they have been moved.
+    void refresh();
+
+    // Closest of the balls in [first, first + count) that the ray intersects within t. The index
+    // of the ball is returned as the primitive of the intersection.
+    intersection_opt closest_hit(const struct line&, const uint32_t first, const uint32_t count, const min_max<float> t) const;
+    // Whether the ray intersects any of the balls in [first, first + count) within t.
+    bool occluded(const struct line&, const uint32_t first, const uint32_t count, const min_max<float> t) const;
+
+private:
+    void store(const size_t i, const ball&);
+
+    // Returns a bit for each of the eight balls starting at index i that the ray intersects within t,
+    // and the distances of those intersections in roots.
+    uint32_t hit_lanes(const struct line&, const uint32_t i, const min_max<float> t, std::array<float, lane_count>& roots) const;
+
+private:
+    // Each array ends with lane_count placeholders, so that loads starting at any ball stay in bounds.
+    std::vector<float> center_x;
+    std::vector<float> center_y;
+    std::vector<float> center_z;
+    std::vector<float> motion_x;
+    std::vector<float> motion_y;
+    std::vector<float> motion_z;
+    std::vector<float> start_time;
+    std::vector<float> inverse_duration;
+    std::vector<float> radius;
+    std::vector<const ball*> balls;
+};
\ No newline at end of file
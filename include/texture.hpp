@@ -1,15 +1,17 @@
 #pragma once
 
-#include <util/colors.hpp>
-#include <util/vector_types.hpp>
+#include <util/numeric_types.hpp>
 
-#include <memory>
-
-class texture
+enum class texture_type
 {
-public:
-    virtual ~texture() = default;
-    virtual color value_at(const std::pair<float, float> uv, const position&) const = 0;
+    none, checker, constant, image, noise
 };
 
-using unique_texture = std::unique_ptr<texture>;
\ No newline at end of file
+// Refers to a texture stored in the scene's array for its type. Textures made of other textures
+// refer to them the same way, so that a whole texture is a flat graph of such nodes. Aligned like
+// a structure in the std140 scene block of the shaders.
+struct alignas(16) texture
+{
+    texture_type type = texture_type::none;
+    array_index index = 0;
+};
\ No newline at end of file
@@ -1,18 +1,19 @@
 #pragma once
 
 #include <texture.hpp>
+#include <util/vector_types.hpp>
 
-class checker_texture : public texture
+class checker_texture
 {
 public:
     checker_texture() = default;
-    checker_texture(const float scale, const color& odd, const color& even);
-    checker_texture(const float scale, unique_texture&& odd, unique_texture&& even);
+    checker_texture(const float scale, const texture& odd, const texture& even);
 
-    virtual color value_at(const std::pair<float, float> uv, const position&) const override;
+    // The texture shown at the point.
+    const texture& select(const position&) const;
 
 private:
     float scale = 1.f;
-    unique_texture odd;
-    unique_texture even;
+    texture odd;
+    texture even;
 };
\ No newline at end of file
@@ -1,15 +1,16 @@
 #pragma once
 
-#include <texture.hpp>
+#include <util/colors.hpp>
 
-class constant_texture : public texture
+class constant_texture
 {
 public:
     constant_texture() = default;
     constant_texture(const color&);
 
-    virtual color value_at(const std::pair<float, float> uv, const position&) const override;
+    color value_at() const;
 
 private:
-    color value;
+    // Padded to the 16 bytes of a structure in std140.
+    alignas(16) color value;
 };
\ No newline at end of file
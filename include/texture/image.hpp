@@ -1,20 +1,35 @@
 #pragma once
 
-#include <texture.hpp>
+#include <util/colors.hpp>
+#include <util/numeric_types.hpp>
 #include <util/sizes.hpp>
 
-#include <string>
+#include <memory_resource>
+#include <string_view>
+#include <utility>
 #include <vector>
 
-class image_texture : public texture
+// Texels row by row, from the top row down. Once added to a scene, they are allocated from the
+// scene's memory resource like the rest of its arrays.
+struct image
+{
+    std::pmr::vector<color> texels;
+    extent_2d<uint32_t> size;
+};
+
+image load_image(std::string_view image_path);
+
+// Shows one of the images stored by the scene.
+class image_texture
 {
 public:
     image_texture() = default;
-    image_texture(std::string_view image_path);
-    image_texture(const std::vector<color>& data, const extent_2d<size_t> size);
-    virtual color value_at(const std::pair<float, float> uv, const position&) const override;
+    image_texture(const array_index image_index, const extent_2d<uint32_t> size);
 
-private:
-    std::vector<color> data;
-    extent_2d<size_t> size;
+    color value_at(const image&, const std::pair<float, float> uv) const;
+
+public:
+    array_index image_index = 0;
+    // Structures start on 16 bytes in std140.
+    alignas(16) extent_2d<uint32_t> size;
 };
\ No newline at end of file
@@ -1,25 +1,39 @@
 #pragma once
 
-#include <texture.hpp>
+#include <util/colors.hpp>
 #include <util/noise.hpp>
+#include <util/numeric_types.hpp>
+#include <util/vector_types.hpp>
 
-#include <functional>
-
-using noise_transform_fn = std::function<float(const perlin&, const glm::vec3&)>;
+// How the Perlin noise at a point is turned into the intensity of the texture.
+enum class noise_transform
+{
+    // 0.5 * (1 + noise)
+    smooth,
+    // |sum of 7 octaves of noise|
+    turbulence,
+    // 0.5 * (1 + turbulence)
+    soft_turbulence,
+    // 0.5 * (1 + sin(z + 10 * turbulence)), veins along the z axis
+    marble,
+};
 
-class noise_texture : public texture
+class noise_texture
 {
 public:
     noise_texture() = default;
-    noise_texture(const float scale, const color& albedo = color{ 1.f }, const noise_transform_fn& =
-        [](const perlin& n, const glm::vec3& p) { return 0.5f * (1.f + n.noise(p)); });
+    noise_texture(const float scale, const color& albedo = color{ 1.f }, const noise_transform = noise_transform::smooth);
 
-    virtual color value_at(const std::pair<float, float> uv, const position&) const override;
+    color value_at(const perlin&, const position&) const;
 
-private:
-    perlin noise;
+public:
+    // The Perlin noise of the scene sampled by the texture, which the scene creates when the
+    // texture is added to it.
+    array_index noise_index = 0;
 
+private:
     float scale;
-    color albedo;
-    noise_transform_fn noise_transform;
+    // Vectors of three start on 16 bytes in std140.
+    alignas(16) color albedo;
+    noise_transform transform;
 };
\ No newline at end of file
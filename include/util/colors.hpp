@@ -16,6 +16,11 @@ static constexpr color yellow = color{ 1.f, 1.f, 0.f };
 static constexpr color magenta = color{ 1.f, 0.f, 1.f };
 static constexpr color cyan = color{ 0.f, 1.f, 1.f };
 
+inline static float luminance(const color& col)
+{
+    return 0.2126f * col.r + 0.7152f * col.g + 0.0722f * col.b;
+}
+
 inline static rgb to_rgb(const color& col)
 {
     return col * 255.99f;
@@ -1,3 +1,7 @@
 #pragma once
 
-using array_index = size_t;
\ No newline at end of file
+#include <cstddef>
+#include <cstdint>
+
+// 32 bits, like the indices of the shaders, so that handles have the same layout on both sides.
+using array_index = uint32_t;
\ No newline at end of file
@@ -3,16 +3,107 @@
 #include <util/colors.hpp>
 #include <util/vector_types.hpp>
 
-#include <chrono>
+#include <cstdint>
+#include <limits>
 #include <random>
 #include <type_traits>
 
+// PCG-XSH-RR generator (O'Neill 2014): 64 bits of state, 32-bit output, selectable stream.
+class pcg32
+{
+public:
+    using result_type = uint32_t;
+
+    inline static constexpr uint64_t default_seed = 0x853c49e6748fea9bull;
+    inline static constexpr uint64_t default_stream = 0xda3e39cb94b95bdbull;
+
+public:
+    constexpr pcg32(const uint64_t seed = default_seed, const uint64_t stream = default_stream)
+    {
+        this->seed(seed, stream);
+    }
+
+    constexpr void seed(const uint64_t seed, const uint64_t stream = default_stream)
+    {
+        this->state = 0u;
+        this->increment = (stream << 1u) | 1u;
+        (*this)();
+        this->state += seed;
+        (*this)();
+    }
+
+    constexpr result_type operator()()
+    {
+        const uint64_t old_state = this->state;
+        this->state = old_state * 6364136223846793005ull + this->increment;
+        const uint32_t xor_shifted = uint32_t(((old_state >> 18u) ^ old_state) >> 27u);
+        const uint32_t rotation = uint32_t(old_state >> 59u);
+        return (xor_shifted >> rotation) | (xor_shifted << ((~rotation + 1u) & 31u));
+    }
+
+    // Uniformly distributed in [0, 1).
+    constexpr float next_float()
+    {
+        return float((*this)() >> 8u) * (1.f / 16777216.f);
+    }
+
+    // Uniformly distributed in [0, bound), with Lemire's multiply and reject (2019): the high half
+    // of the 64-bit product is the result, and the few low halves that would bias it are redrawn.
+    constexpr result_type next_bounded(const result_type bound)
+    {
+        uint64_t product = uint64_t((*this)()) * bound;
+        if (uint32_t(product) < bound)
+        {
+            const uint32_t threshold = (~bound + 1u) % bound;
+            while (uint32_t(product) < threshold)
+            {
+                product = uint64_t((*this)()) * bound;
+            }
+        }
+        return result_type(product >> 32u);
+    }
+
+    static constexpr result_type min()
+    {
+        return std::numeric_limits<result_type>::min();
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+private:
+    uint64_t state = 0u;
+    uint64_t increment = 0u;
+};
+
+// SplitMix64 finalizer, used to derive independent seeds from a base seed and a counter.
+inline static constexpr uint64_t mix_seed(const uint64_t seed, const uint64_t counter)
+{
+    uint64_t z = seed + (counter + 1u) * 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27u)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31u);
+}
+
+// Every thread owns its own engine, so the random_* helpers below are free of data races and
+// contention. Not static on purpose: all translation units must share the same instance.
+inline pcg32& thread_random_engine()
+{
+    thread_local pcg32 engine;
+    return engine;
+}
+
+// Reseeds the calling thread's engine, making the following random_* results reproducible.
+inline void seed_random(const uint64_t seed, const uint64_t stream = pcg32::default_stream)
+{
+    thread_random_engine().seed(seed, stream);
+}
+
 inline static bool random_chance(const float probability = 0.5f)
 {
-    static const auto seed = uint32_t(std::chrono::system_clock::now().time_since_epoch().count());
-    static std::default_random_engine rng{ seed };
-    std::bernoulli_distribution distribution{ probability };
-    return distribution(rng);
+    return thread_random_engine().next_float() < probability;
 }
 
 template <typename T>
@@ -20,18 +111,23 @@ inline static auto random_uniform(const T min = T(0), const T max = T(1))
 {
     static_assert(std::is_arithmetic_v<T>);
 
-    static const auto seed = uint32_t(std::chrono::system_clock::now().time_since_epoch().count());
-    static std::default_random_engine rng{ seed };
-
     if constexpr (std::is_integral_v<T>)
     {
-        std::uniform_int_distribution<T> distribution{ min, max };
-        return distribution(rng);
+        static_assert(sizeof(T) <= sizeof(pcg32::result_type));
+
+        // The whole 32-bit range wraps to a bound of 0 and takes the generator's output as it is.
+        const uint32_t bound = uint32_t(max) - uint32_t(min) + 1u;
+        pcg32& engine = thread_random_engine();
+        return T(uint32_t(min) + (bound == 0u ? engine() : engine.next_bounded(bound)));
+    }
+    else if constexpr (std::is_same_v<T, float>)
+    {
+        return min + (max - min) * thread_random_engine().next_float();
     }
-    else if constexpr (std::is_floating_point_v<T>)
+    else
     {
         std::uniform_real_distribution<T> distribution{ min, max };
-        return distribution(rng);
+        return distribution(thread_random_engine());
     }
 }
 
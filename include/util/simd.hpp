@@ -0,0 +1,196 @@
+#pragma once
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define SIMD_SSE 1
+#   include <immintrin.h>
+#else
+#   define SIMD_SSE 0
+#endif
+
+#if defined(__AVX2__)
+#   define SIMD_AVX2 1
+#else
+#   define SIMD_AVX2 0
+#endif
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+// Four floats processed with one SSE instruction, or one after another where SSE is not available.
+// Lane-wise min and max return the second operand if either one is NaN, like their SSE counterparts.
+struct float4
+{
+#if SIMD_SSE
+    __m128 v;
+
+    float4() = default;
+    float4(const __m128 v) : v(v) {}
+    explicit float4(const float f) : v(_mm_set1_ps(f)) {}
+
+    // The pointer has to be aligned to 16 bytes.
+    static float4 load(const float* p) { return _mm_load_ps(p); }
+    static float4 load_unaligned(const float* p) { return _mm_loadu_ps(p); }
+    void store(float* p) const { _mm_store_ps(p, this->v); }
+#else
+    std::array<float, 4> v;
+
+    float4() = default;
+    explicit float4(const float f) : v{ f, f, f, f } {}
+
+    static float4 load(const float* p) { return float4{ std::array<float, 4>{ p[0], p[1], p[2], p[3] } }; }
+    static float4 load_unaligned(const float* p) { return load(p); }
+    void store(float* p) const { for (size_t i = 0; i < 4; ++i) p[i] = this->v[i]; }
+
+private:
+    explicit float4(const std::array<float, 4>& v) : v(v) {}
+
+    template<typename F>
+    friend float4 lane_wise(const float4&, const float4&, F);
+#endif
+};
+
+// Result of a lane-wise comparison.
+struct mask4
+{
+#if SIMD_SSE
+    __m128 v;
+#else
+    std::array<bool, 4> v;
+#endif
+};
+
+#if SIMD_SSE
+
+inline float4 operator+(const float4 a, const float4 b) { return _mm_add_ps(a.v, b.v); }
+inline float4 operator-(const float4 a, const float4 b) { return _mm_sub_ps(a.v, b.v); }
+inline float4 operator*(const float4 a, const float4 b) { return _mm_mul_ps(a.v, b.v); }
+inline float4 operator/(const float4 a, const float4 b) { return _mm_div_ps(a.v, b.v); }
+inline float4 min(const float4 a, const float4 b) { return _mm_min_ps(a.v, b.v); }
+inline float4 max(const float4 a, const float4 b) { return _mm_max_ps(a.v, b.v); }
+inline float4 sqrt(const float4 a) { return _mm_sqrt_ps(a.v); }
+
+inline mask4 operator<(const float4 a, const float4 b) { return mask4{ _mm_cmplt_ps(a.v, b.v) }; }
+inline mask4 operator<=(const float4 a, const float4 b) { return mask4{ _mm_cmple_ps(a.v, b.v) }; }
+inline mask4 operator&(const mask4 a, const mask4 b) { return mask4{ _mm_and_ps(a.v, b.v) }; }
+inline mask4 operator|(const mask4 a, const mask4 b) { return mask4{ _mm_or_ps(a.v, b.v) }; }
+
+// Lane-wise a where the mask is set, b elsewhere.
+inline float4 select(const mask4 m, const float4 a, const float4 b) { return _mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v)); }
+
+// Bit i is set if lane i of the mask is.
+inline uint32_t bits(const mask4 m) { return uint32_t(_mm_movemask_ps(m.v)); }
+
+#else
+
+template<typename F>
+float4 lane_wise(const float4& a, const float4& b, F f)
+{
+    return float4{ std::array<float, 4>{ f(a.v[0], b.v[0]), f(a.v[1], b.v[1]), f(a.v[2], b.v[2]), f(a.v[3], b.v[3]) } };
+}
+
+inline float4 operator+(const float4 a, const float4 b) { return lane_wise(a, b, [](const float x, const float y) { return x + y; }); }
+inline float4 operator-(const float4 a, const float4 b) { return lane_wise(a, b, [](const float x, const float y) { return x - y; }); }
+inline float4 operator*(const float4 a, const float4 b) { return lane_wise(a, b, [](const float x, const float y) { return x * y; }); }
+inline float4 operator/(const float4 a, const float4 b) { return lane_wise(a, b, [](const float x, const float y) { return x / y; }); }
+inline float4 min(const float4 a, const float4 b) { return lane_wise(a, b, [](const float x, const float y) { return x < y ? x : y; }); }
+inline float4 max(const float4 a, const float4 b) { return lane_wise(a, b, [](const float x, const float y) { return x > y ? x : y; }); }
+inline float4 sqrt(const float4 a) { return lane_wise(a, a, [](const float x, const float) { return std::sqrt(x); }); }
+
+inline mask4 operator<(const float4 a, const float4 b) { return mask4{ { a.v[0] < b.v[0], a.v[1] < b.v[1], a.v[2] < b.v[2], a.v[3] < b.v[3] } }; }
+inline mask4 operator<=(const float4 a, const float4 b) { return mask4{ { a.v[0] <= b.v[0], a.v[1] <= b.v[1], a.v[2] <= b.v[2], a.v[3] <= b.v[3] } }; }
+inline mask4 operator&(const mask4 a, const mask4 b) { return mask4{ { a.v[0] && b.v[0], a.v[1] && b.v[1], a.v[2] && b.v[2], a.v[3] && b.v[3] } }; }
+inline mask4 operator|(const mask4 a, const mask4 b) { return mask4{ { a.v[0] || b.v[0], a.v[1] || b.v[1], a.v[2] || b.v[2], a.v[3] || b.v[3] } }; }
+
+inline float4 select(const mask4 m, const float4 a, const float4 b)
+{
+    float4 result = b;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        if (m.v[i]) result.v[i] = a.v[i];
+    }
+    return result;
+}
+
+inline uint32_t bits(const mask4 m) { return uint32_t(m.v[0]) | uint32_t(m.v[1]) << 1 | uint32_t(m.v[2]) << 2 | uint32_t(m.v[3]) << 3; }
+
+#endif
+
+// Eight floats in one AVX register, or in two halves of four where AVX2 is not enabled.
+#if SIMD_AVX2
+
+struct float8
+{
+    __m256 v;
+
+    float8() = default;
+    float8(const __m256 v) : v(v) {}
+    explicit float8(const float f) : v(_mm256_set1_ps(f)) {}
+
+    static float8 load_unaligned(const float* p) { return _mm256_loadu_ps(p); }
+    void store_unaligned(float* p) const { _mm256_storeu_ps(p, this->v); }
+};
+
+struct mask8
+{
+    __m256 v;
+};
+
+inline float8 operator+(const float8 a, const float8 b) { return _mm256_add_ps(a.v, b.v); }
+inline float8 operator-(const float8 a, const float8 b) { return _mm256_sub_ps(a.v, b.v); }
+inline float8 operator*(const float8 a, const float8 b) { return _mm256_mul_ps(a.v, b.v); }
+inline float8 operator/(const float8 a, const float8 b) { return _mm256_div_ps(a.v, b.v); }
+inline float8 sqrt(const float8 a) { return _mm256_sqrt_ps(a.v); }
+inline float8 min(const float8 a, const float8 b) { return _mm256_min_ps(a.v, b.v); }
+inline float8 max(const float8 a, const float8 b) { return _mm256_max_ps(a.v, b.v); }
+
+inline mask8 operator<(const float8 a, const float8 b) { return mask8{ _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+inline mask8 operator&(const mask8 a, const mask8 b) { return mask8{ _mm256_and_ps(a.v, b.v) }; }
+inline mask8 operator|(const mask8 a, const mask8 b) { return mask8{ _mm256_or_ps(a.v, b.v) }; }
+
+inline float8 select(const mask8 m, const float8 a, const float8 b) { return _mm256_blendv_ps(b.v, a.v, m.v); }
+inline uint32_t bits(const mask8 m) { return uint32_t(_mm256_movemask_ps(m.v)); }
+
+#else
+
+struct float8
+{
+    float4 low;
+    float4 high;
+
+    float8() = default;
+    float8(const float4 low, const float4 high) : low(low), high(high) {}
+    explicit float8(const float f) : low(f), high(f) {}
+
+    static float8 load_unaligned(const float* p) { return float8{ float4::load_unaligned(p), float4::load_unaligned(p + 4) }; }
+    void store_unaligned(float* p) const
+    {
+        alignas(16) std::array<float, 8> lanes;
+        this->low.store(lanes.data());
+        this->high.store(lanes.data() + 4);
+        for (size_t i = 0; i < 8; ++i) p[i] = lanes[i];
+    }
+};
+
+struct mask8
+{
+    mask4 low;
+    mask4 high;
+};
+
+inline float8 operator+(const float8 a, const float8 b) { return float8{ a.low + b.low, a.high + b.high }; }
+inline float8 operator-(const float8 a, const float8 b) { return float8{ a.low - b.low, a.high - b.high }; }
+inline float8 operator*(const float8 a, const float8 b) { return float8{ a.low * b.low, a.high * b.high }; }
+inline float8 operator/(const float8 a, const float8 b) { return float8{ a.low / b.low, a.high / b.high }; }
+inline float8 sqrt(const float8 a) { return float8{ sqrt(a.low), sqrt(a.high) }; }
+inline float8 min(const float8 a, const float8 b) { return float8{ min(a.low, b.low), min(a.high, b.high) }; }
+inline float8 max(const float8 a, const float8 b) { return float8{ max(a.low, b.low), max(a.high, b.high) }; }
+
+inline mask8 operator<(const float8 a, const float8 b) { return mask8{ a.low < b.low, a.high < b.high }; }
+inline mask8 operator&(const mask8 a, const mask8 b) { return mask8{ a.low & b.low, a.high & b.high }; }
+inline mask8 operator|(const mask8 a, const mask8 b) { return mask8{ a.low | b.low, a.high | b.high }; }
+
+inline float8 select(const mask8 m, const float8 a, const float8 b) { return float8{ select(m.low, a.low, b.low), select(m.high, a.high, b.high) }; }
+inline uint32_t bits(const mask8 m) { return bits(m.low) | bits(m.high) << 4; }
+
+#endif
\ No newline at end of file
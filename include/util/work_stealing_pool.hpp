@@ -0,0 +1,62 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+enum class thread_affinity
+{
+    none,             // Workers are placed by the OS scheduler.
+    pinned,           // Worker i is pinned to the i-th CPU available to the process.
+    numa_interleaved, // Workers are pinned round-robin across NUMA nodes.
+};
+
+class work_stealing_pool
+{
+public:
+    using job = std::function<void()>;
+
+public:
+    work_stealing_pool(const uint32_t thread_count, const thread_affinity = thread_affinity::none);
+    ~work_stealing_pool();
+
+    work_stealing_pool(const work_stealing_pool&) = delete;
+    work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+    // Spreads the jobs over the workers' queues in contiguous chunks and blocks until all of them
+    // are done. A worker that runs out of its own jobs steals from the back of the other queues.
+    void run(std::vector<job>&& jobs);
+
+    uint32_t size() const;
+
+private:
+    void work(const uint32_t worker_index);
+    std::optional<job> take_job(const uint32_t worker_index);
+
+    static std::vector<uint32_t> cpu_placement(const thread_affinity);
+    static void pin_to_cpu(std::thread&, const uint32_t cpu);
+
+private:
+    struct job_queue
+    {
+        std::deque<job> jobs;
+        std::mutex mtx;
+    };
+
+    std::vector<std::unique_ptr<job_queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex state_mtx;
+    std::condition_variable work_available;
+    std::condition_variable work_finished;
+    size_t pending_jobs = 0;
+    uint64_t batch = 0;
+    bool stopping = false;
+    std::exception_ptr first_error;
+};
\ No newline at end of file
@@ -0,0 +1,888 @@
+#include <bounding_volume_hierarchy/linear_bounding_volume_hierarchy.hpp>
+
+#include <line.hpp>
+#include <util/simd.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+linear_bounding_volume_hierarchy::linear_bounding_volume_hierarchy(const std::pmr::vector<shape>& shapes,
+    const std::pmr::vector<ball>& balls, const min_max<float> time, const bounding_volume_hierarchy_create_info& info)
+    : info(info)
+    , parallel_build_depth(uint32_t(std::ceil(std::log2(std::max(std::thread::hardware_concurrency(), 1u)))) + 1)
+    , scene_balls(balls.data())
+{
+    if (this->info.max_leaf_size == 0 || this->info.bin_count < 2)
+    {
+        throw std::runtime_error{ "linear_bounding_volume_hierarchy: Leaves must hold a primitive and there must be at least 2 bins." };
+    }
+
+    std::vector<build_primitive> build_primitives;
+    build_primitives.reserve(shapes.size());
+    for (const shape& object : shapes)
+    {
+        const axis_aligned_bounding_box_opt box = this->bounding_box_of(object, time);
+        if (!box)
+        {
+            throw std::runtime_error{ "No bounding boxes could be obtained." };
+        }
+        build_primitives.push_back(build_primitive{ *box, 0.5f * (box->min + box->max), object });
+    }
+
+    if (!build_primitives.empty())
+    {
+        subtree root = this->build_in_parallel(build_primitives, 0, build_primitives.size(), 0);
+        this->nodes = std::move(root.nodes);
+        this->primitives = std::move(root.primitives);
+        for (const shape& primitive : this->primitives)
+        {
+            this->balls.push_back(primitive.type == shape_type::ball ? &this->scene_balls[primitive.index] : nullptr);
+        }
+        this->collapse(0);
+    }
+}
+
+intersection_opt linear_bounding_volume_hierarchy::intersect(const line& ray, const min_max<float> t) const
+{
+    if (this->wide_nodes.empty())
+    {
+        return {};
+    }
+
+    // Knowing the direction, the near and far planes of all boxes are known up front.
+    const bool negative_x = ray.is_negative[0];
+    const bool negative_y = ray.is_negative[1];
+    const bool negative_z = ray.is_negative[2];
+    const float4 origin_x{ ray.origin.x };
+    const float4 origin_y{ ray.origin.y };
+    const float4 origin_z{ ray.origin.z };
+    const float4 inverse_direction_x{ ray.inverse_direction.x };
+    const float4 inverse_direction_y{ ray.inverse_direction.y };
+    const float4 inverse_direction_z{ ray.inverse_direction.z };
+
+    // Every visited node replaces itself with at most four children.
+    struct entry
+    {
+        uint32_t node;
+        float t;
+    };
+    std::array<entry, (width - 1) * max_depth + 1> to_visit;
+    size_t to_visit_count = 0;
+    to_visit[to_visit_count++] = entry{ 0, t.min };
+
+    intersection_opt closest;
+    min_max<float> interval = t;
+    while (to_visit_count > 0)
+    {
+        const entry current = to_visit[--to_visit_count];
+        if (current.t > interval.max)
+        {
+            continue;
+        }
+
+        const wide_node& n = this->wide_nodes[current.node];
+        const float4 near_x = (float4::load(negative_x ? n.max_x.data() : n.min_x.data()) - origin_x) * inverse_direction_x;
+        const float4 near_y = (float4::load(negative_y ? n.max_y.data() : n.min_y.data()) - origin_y) * inverse_direction_y;
+        const float4 near_z = (float4::load(negative_z ? n.max_z.data() : n.min_z.data()) - origin_z) * inverse_direction_z;
+        const float4 far_x = (float4::load(negative_x ? n.min_x.data() : n.max_x.data()) - origin_x) * inverse_direction_x;
+        const float4 far_y = (float4::load(negative_y ? n.min_y.data() : n.max_y.data()) - origin_y) * inverse_direction_y;
+        const float4 far_z = (float4::load(negative_z ? n.min_z.data() : n.max_z.data()) - origin_z) * inverse_direction_z;
+        // Distances are chained into the interval as first operands, so NaNs from rays lying in a slab's plane drop out.
+        const float4 entry_t = max(near_x, max(near_y, max(near_z, float4{ interval.min })));
+        const float4 exit_t = min(far_x, min(far_y, min(far_z, float4{ interval.max })));
+
+        uint32_t hit_mask = bits(entry_t <= exit_t);
+        if (hit_mask == 0)
+        {
+            continue;
+        }
+
+        alignas(16) std::array<float, width> entry_ts;
+        entry_t.store(entry_ts.data());
+
+        // Sort the hit children front to back.
+        std::array<uint32_t, width> order;
+        uint32_t order_count = 0;
+        for (uint32_t child = 0; child < width; ++child)
+        {
+            if (hit_mask & (1u << child))
+            {
+                uint32_t i = order_count++;
+                for (; i > 0 && entry_ts[order[i - 1]] > entry_ts[child]; --i)
+                {
+                    order[i] = order[i - 1];
+                }
+                order[i] = child;
+            }
+        }
+
+        // Leaves are intersected right away, so the shortened interval can cull the children behind them.
+        uint32_t interior_count = 0;
+        for (uint32_t i = 0; i < order_count; ++i)
+        {
+            const uint32_t child = order[i];
+            if (n.primitive_count[child] == 0)
+            {
+                order[interior_count++] = child;
+                continue;
+            }
+            if (entry_ts[child] > interval.max)
+            {
+                continue;
+            }
+            if (n.ball_leaf[child])
+            {
+                if (const intersection_opt i = this->balls.closest_hit(ray, n.offset[child], n.primitive_count[child], interval))
+                {
+                    interval.max = i->t;
+                    closest = i;
+                }
+                continue;
+            }
+            for (uint32_t p = n.offset[child]; p < n.offset[child] + n.primitive_count[child]; ++p)
+            {
+                if (const intersection_opt i = this->intersect_primitive(p, ray, interval))
+                {
+                    interval.max = i->t;
+                    closest = intersection{ i->t, p };
+                }
+            }
+        }
+
+        // The nearest interior child is pushed last to be visited next.
+        for (uint32_t i = interior_count; i-- > 0;)
+        {
+            to_visit[to_visit_count++] = entry{ n.offset[order[i]], entry_ts[order[i]] };
+        }
+    }
+    return closest;
+}
+
+hit_record linear_bounding_volume_hierarchy::finalize(const line& ray, const intersection& i) const
+{
+    const shape& s = this->primitives[i.primitive];
+    switch (s.type)
+    {
+    case shape_type::ball:
+        return this->scene_balls[s.index].finalize(ray, intersection{ i.t });
+    case shape_type::none:
+        break;
+    }
+    throw std::runtime_error{ "linear_bounding_volume_hierarchy: Unknown shape type." };
+}
+
+bool linear_bounding_volume_hierarchy::occluded(const line& ray, const min_max<float> t) const
+{
+    if (this->wide_nodes.empty())
+    {
+        return false;
+    }
+
+    const bool negative_x = ray.is_negative[0];
+    const bool negative_y = ray.is_negative[1];
+    const bool negative_z = ray.is_negative[2];
+    const float4 origin_x{ ray.origin.x };
+    const float4 origin_y{ ray.origin.y };
+    const float4 origin_z{ ray.origin.z };
+    const float4 inverse_direction_x{ ray.inverse_direction.x };
+    const float4 inverse_direction_y{ ray.inverse_direction.y };
+    const float4 inverse_direction_z{ ray.inverse_direction.z };
+    const float4 t_min{ t.min };
+    const float4 t_max{ t.max };
+
+    // Any hit will do, so the interval never shrinks and children are visited in any order.
+    std::array<uint32_t, (width - 1) * max_depth + 1> to_visit;
+    size_t to_visit_count = 0;
+    to_visit[to_visit_count++] = 0;
+
+    while (to_visit_count > 0)
+    {
+        const wide_node& n = this->wide_nodes[to_visit[--to_visit_count]];
+        const float4 near_x = (float4::load(negative_x ? n.max_x.data() : n.min_x.data()) - origin_x) * inverse_direction_x;
+        const float4 near_y = (float4::load(negative_y ? n.max_y.data() : n.min_y.data()) - origin_y) * inverse_direction_y;
+        const float4 near_z = (float4::load(negative_z ? n.max_z.data() : n.min_z.data()) - origin_z) * inverse_direction_z;
+        const float4 far_x = (float4::load(negative_x ? n.min_x.data() : n.max_x.data()) - origin_x) * inverse_direction_x;
+        const float4 far_y = (float4::load(negative_y ? n.min_y.data() : n.max_y.data()) - origin_y) * inverse_direction_y;
+        const float4 far_z = (float4::load(negative_z ? n.min_z.data() : n.max_z.data()) - origin_z) * inverse_direction_z;
+        const float4 entry_t = max(near_x, max(near_y, max(near_z, t_min)));
+        const float4 exit_t = min(far_x, min(far_y, min(far_z, t_max)));
+
+        const uint32_t hit_mask = bits(entry_t <= exit_t);
+        for (uint32_t child = 0; child < width; ++child)
+        {
+            if (!(hit_mask & (1u << child)))
+            {
+                continue;
+            }
+            if (n.primitive_count[child] == 0)
+            {
+                to_visit[to_visit_count++] = n.offset[child];
+                continue;
+            }
+            if (n.ball_leaf[child])
+            {
+                if (this->balls.occluded(ray, n.offset[child], n.primitive_count[child], t))
+                {
+                    return true;
+                }
+                continue;
+            }
+            for (uint32_t p = n.offset[child]; p < n.offset[child] + n.primitive_count[child]; ++p)
+            {
+                if (this->primitive_occluded(p, ray, t))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void linear_bounding_volume_hierarchy::hit(const line_packet& packet, const min_max<float> t,
+    std::array<hit_record_opt, line_packet::size>& hits) const
+{
+    if (this->wide_nodes.empty() || packet.count() == 0)
+    {
+        return;
+    }
+
+    const bool coherent = packet.is_coherent();
+    alignas(16) std::array<float, line_packet::size> t_max;
+    t_max.fill(t.max);
+    std::array<intersection_opt, line_packet::size> closest;
+
+    // Entries keep the nearest distance at which any of their rays enters the node.
+    struct entry
+    {
+        uint32_t node;
+        uint32_t lanes;
+        float t;
+    };
+    std::array<entry, (width - 1) * max_depth + 1> to_visit;
+    size_t to_visit_count = 0;
+    to_visit[to_visit_count++] = entry{ 0, packet.active_mask(), t.min };
+
+    while (to_visit_count > 0)
+    {
+        const entry current = to_visit[--to_visit_count];
+
+        // Rays that have found a hit before the node since it was pushed cannot hit anything in it.
+        uint32_t lanes = current.lanes;
+        float farthest = t.min;
+        for (uint32_t lane = 0; lane < line_packet::size; ++lane)
+        {
+            if (t_max[lane] < current.t)
+            {
+                lanes &= ~(1u << lane);
+            }
+            else if (lanes & (1u << lane))
+            {
+                farthest = std::max(farthest, t_max[lane]);
+            }
+        }
+        if (lanes == 0)
+        {
+            continue;
+        }
+
+        const wide_node& n = this->wide_nodes[current.node];
+
+        struct visit
+        {
+            float t;
+            uint32_t child;
+            uint32_t lanes;
+            alignas(16) std::array<float, line_packet::size> entry_ts;
+        };
+        std::array<visit, width> visits;
+        uint32_t visit_count = 0;
+        const uint32_t candidates = coherent ? packet_may_hit_children(packet, n, min_max<float>{ t.min, farthest }) : ~0u;
+        for (uint32_t child = 0; child < width; ++child)
+        {
+            // Only unused slots have neither primitives nor a child node, as the root is nobody's child.
+            if (!(candidates & (1u << child)) || (n.primitive_count[child] == 0 && n.offset[child] == 0))
+            {
+                continue;
+            }
+
+            const axis_aligned_bounding_box box{
+                position{ n.min_x[child], n.min_y[child], n.min_z[child] },
+                position{ n.max_x[child], n.max_y[child], n.max_z[child] } };
+
+            visit v;
+            v.child = child;
+            v.lanes = lanes & packet_hits_box(packet, box, t.min, t_max, v.entry_ts, v.t);
+            if (v.lanes != 0)
+            {
+                uint32_t i = visit_count++;
+                for (; i > 0 && visits[i - 1].t > v.t; --i)
+                {
+                    visits[i] = visits[i - 1];
+                }
+                visits[i] = v;
+            }
+        }
+
+        uint32_t interior_count = 0;
+        for (uint32_t i = 0; i < visit_count; ++i)
+        {
+            const visit& v = visits[i];
+            if (n.primitive_count[v.child] == 0)
+            {
+                visits[interior_count++] = v;
+                continue;
+            }
+
+            // Leaves nearer to the rays may have shortened their intervals since the boxes were tested.
+            uint32_t leaf_lanes = v.lanes;
+            for (uint32_t lane = 0; lane < line_packet::size; ++lane)
+            {
+                if (v.entry_ts[lane] > t_max[lane])
+                {
+                    leaf_lanes &= ~(1u << lane);
+                }
+            }
+
+            if (n.ball_leaf[v.child])
+            {
+                for (uint32_t lane = 0; lane < line_packet::size; ++lane)
+                {
+                    if (leaf_lanes & (1u << lane))
+                    {
+                        if (const intersection_opt i = this->balls.closest_hit(packet[lane],
+                            n.offset[v.child], n.primitive_count[v.child], min_max<float>{ t.min, t_max[lane] }))
+                        {
+                            t_max[lane] = i->t;
+                            closest[lane] = i;
+                        }
+                    }
+                }
+                continue;
+            }
+            for (uint32_t p = n.offset[v.child]; p < n.offset[v.child] + n.primitive_count[v.child]; ++p)
+            {
+                for (uint32_t lane = 0; lane < line_packet::size; ++lane)
+                {
+                    if (leaf_lanes & (1u << lane))
+                    {
+                        if (const intersection_opt i = this->intersect_primitive(p, packet[lane], min_max<float>{ t.min, t_max[lane] }))
+                        {
+                            t_max[lane] = i->t;
+                            closest[lane] = intersection{ i->t, p };
+                        }
+                    }
+                }
+            }
+        }
+
+        for (uint32_t i = interior_count; i-- > 0;)
+        {
+            to_visit[to_visit_count++] = entry{ n.offset[visits[i].child], visits[i].lanes, visits[i].t };
+        }
+    }
+
+    for (uint32_t lane = 0; lane < line_packet::size; ++lane)
+    {
+        if (closest[lane])
+        {
+            hits[lane] = this->finalize(packet[lane], *closest[lane]);
+        }
+    }
+}
+
+axis_aligned_bounding_box_opt linear_bounding_volume_hierarchy::bounding_box(const min_max<float>) const
+{
+    if (this->nodes.empty())
+    {
+        return {};
+    }
+    return this->nodes.front().box;
+}
+
+void linear_bounding_volume_hierarchy::refit(const min_max<float> time)
+{
+    // The leaves test copies of the balls, which have to follow the balls of the scene.
+    this->balls.refresh();
+
+    // Children always come after their parent, so walking the array backwards visits them first.
+    for (size_t i = this->nodes.size(); i-- > 0;)
+    {
+        node& n = this->nodes[i];
+        if (n.primitive_count > 0)
+        {
+            for (uint32_t p = n.offset; p < n.offset + n.primitive_count; ++p)
+            {
+                const axis_aligned_bounding_box_opt box = this->bounding_box_of(this->primitives[p], time);
+                if (!box)
+                {
+                    throw std::runtime_error{ "No bounding boxes could be obtained." };
+                }
+                n.box = p == n.offset ? *box : axis_aligned_bounding_box::surrounding(n.box, *box);
+            }
+        }
+        else
+        {
+            n.box = axis_aligned_bounding_box::surrounding(this->nodes[i + 1].box, this->nodes[n.offset].box);
+        }
+    }
+
+    // Collapsing is linear as well and leaves the wide nodes with the same topology.
+    this->wide_nodes.clear();
+    if (!this->nodes.empty())
+    {
+        this->collapse(0);
+    }
+}
+
+float linear_bounding_volume_hierarchy::sah_cost() const
+{
+    if (this->nodes.empty())
+    {
+        return 0.f;
+    }
+
+    const float inverse_root_area = 1.f / std::max(this->nodes.front().box.surface_area(), FLT_MIN);
+    float cost = 0.f;
+    for (const node& n : this->nodes)
+    {
+        const float hit_probability = n.box.surface_area() * inverse_root_area;
+        cost += n.primitive_count > 0
+            ? hit_probability * this->info.intersection_cost * n.primitive_count
+            : hit_probability * this->info.traversal_cost;
+    }
+    return cost;
+}
+
+linear_bounding_volume_hierarchy::subtree linear_bounding_volume_hierarchy::build_in_parallel(
+    std::vector<build_primitive>& build_primitives, const size_t begin, const size_t end, const uint32_t depth) const
+{
+    subtree result;
+    if (end - begin < parallel_build_threshold || depth >= this->parallel_build_depth)
+    {
+        result.nodes.reserve(2 * (end - begin));
+        result.primitives.reserve(end - begin);
+        this->build(build_primitives, begin, end, depth, result);
+        return result;
+    }
+
+    const partition p = this->partition_node(build_primitives, begin, end, depth);
+    if (p.is_leaf)
+    {
+        make_leaf(build_primitives, begin, end, p.box, result);
+        return result;
+    }
+
+    // The two halves touch disjoint ranges of the primitives, so they can be built concurrently.
+    std::future<subtree> first_child = std::async(std::launch::async, &linear_bounding_volume_hierarchy::build_in_parallel,
+        this, std::ref(build_primitives), begin, p.middle, depth + 1);
+    const subtree second_child = this->build_in_parallel(build_primitives, p.middle, end, depth + 1);
+    const subtree first_child_result = first_child.get();
+
+    result.nodes.reserve(1 + first_child_result.nodes.size() + second_child.nodes.size());
+    result.primitives.reserve(first_child_result.primitives.size() + second_child.primitives.size());
+    result.nodes.push_back(node{ p.box, uint32_t(1 + first_child_result.nodes.size()), 0, p.axis, 0 });
+    append_subtree(result, first_child_result);
+    append_subtree(result, second_child);
+    return result;
+}
+
+uint32_t linear_bounding_volume_hierarchy::build(std::vector<build_primitive>& build_primitives,
+    const size_t begin, const size_t end, const uint32_t depth, subtree& out) const
+{
+    const partition p = this->partition_node(build_primitives, begin, end, depth);
+    if (p.is_leaf)
+    {
+        return make_leaf(build_primitives, begin, end, p.box, out);
+    }
+
+    const uint32_t index = uint32_t(out.nodes.size());
+    out.nodes.emplace_back();
+
+    this->build(build_primitives, begin, p.middle, depth + 1, out);
+    const uint32_t second_child = this->build(build_primitives, p.middle, end, depth + 1, out);
+
+    out.nodes[index] = node{ p.box, second_child, 0, p.axis, 0 };
+    return index;
+}
+
+linear_bounding_volume_hierarchy::partition linear_bounding_volume_hierarchy::partition_node(
+    std::vector<build_primitive>& build_primitives, const size_t begin, const size_t end, const uint32_t depth) const
+{
+    axis_aligned_bounding_box box = build_primitives[begin].box;
+    axis_aligned_bounding_box centroid_box{ build_primitives[begin].centroid, build_primitives[begin].centroid };
+    for (size_t i = begin + 1; i < end; ++i)
+    {
+        box = axis_aligned_bounding_box::surrounding(box, build_primitives[i].box);
+        centroid_box = axis_aligned_bounding_box::surrounding(centroid_box,
+            axis_aligned_bounding_box{ build_primitives[i].centroid, build_primitives[i].centroid });
+    }
+
+    const size_t count = end - begin;
+    const bool fits_in_leaf = count <= std::numeric_limits<uint16_t>::max();
+    if (fits_in_leaf && (count == 1 || depth + 1 >= max_depth))
+    {
+        return partition{ box, true, end, 0 };
+    }
+
+    const split best = this->find_split(build_primitives, begin, end, box, centroid_box);
+    const float leaf_cost = this->info.intersection_cost * count;
+    if (fits_in_leaf && (best.cost == FLT_MAX || (count <= this->info.max_leaf_size && leaf_cost <= best.cost)))
+    {
+        return partition{ box, true, end, 0 };
+    }
+
+    if (best.cost == FLT_MAX)
+    {
+        // Too many primitives with the same centroid to fit in one leaf, split them in half.
+        return partition{ box, false, begin + count / 2, 0 };
+    }
+
+    const float axis_min = centroid_box.min[best.axis];
+    const float bin_scale = this->info.bin_count / (centroid_box.max[best.axis] - axis_min);
+    const auto middle = std::partition(build_primitives.begin() + begin, build_primitives.begin() + end,
+        [&](const build_primitive& p)
+        {
+            return std::min(uint32_t((p.centroid[best.axis] - axis_min) * bin_scale), this->info.bin_count - 1) <= best.bin;
+        });
+    return partition{ box, false, size_t(middle - build_primitives.begin()), best.axis };
+}
+
+intersection_opt linear_bounding_volume_hierarchy::intersect_primitive(const uint32_t p, const line& ray,
+    const min_max<float> t) const
+{
+    const shape& s = this->primitives[p];
+    switch (s.type)
+    {
+    case shape_type::ball:
+        return this->scene_balls[s.index].intersect(ray, t);
+    case shape_type::none:
+        return {};
+    }
+    throw std::runtime_error{ "linear_bounding_volume_hierarchy: Unknown shape type." };
+}
+
+bool linear_bounding_volume_hierarchy::primitive_occluded(const uint32_t p, const line& ray, const min_max<float> t) const
+{
+    const shape& s = this->primitives[p];
+    switch (s.type)
+    {
+    case shape_type::ball:
+        return this->scene_balls[s.index].occluded(ray, t);
+    case shape_type::none:
+        return false;
+    }
+    throw std::runtime_error{ "linear_bounding_volume_hierarchy: Unknown shape type." };
+}
+
+axis_aligned_bounding_box_opt linear_bounding_volume_hierarchy::bounding_box_of(const shape& s, const min_max<float> t) const
+{
+    switch (s.type)
+    {
+    case shape_type::ball:
+        return this->scene_balls[s.index].bounding_box(t);
+    case shape_type::none:
+        return {};
+    }
+    throw std::runtime_error{ "linear_bounding_volume_hierarchy: Unknown shape type." };
+}
+
+uint32_t linear_bounding_volume_hierarchy::make_leaf(const std::vector<build_primitive>& build_primitives,
+    const size_t begin, const size_t end, const axis_aligned_bounding_box& box, subtree& out)
+{
+    const uint32_t index = uint32_t(out.nodes.size());
+    out.nodes.push_back(node{ box, uint32_t(out.primitives.size()), uint16_t(end - begin), 0, 0 });
+    for (size_t i = begin; i < end; ++i)
+    {
+        out.primitives.push_back(build_primitives[i].object);
+    }
+    return index;
+}
+
+void linear_bounding_volume_hierarchy::append_subtree(subtree& destination, const subtree& source)
+{
+    const uint32_t node_base = uint32_t(destination.nodes.size());
+    const uint32_t primitive_base = uint32_t(destination.primitives.size());
+    for (node n : source.nodes)
+    {
+        n.offset += n.primitive_count > 0 ? primitive_base : node_base;
+        destination.nodes.push_back(n);
+    }
+    destination.primitives.insert(destination.primitives.end(), source.primitives.begin(), source.primitives.end());
+}
+
+uint32_t linear_bounding_volume_hierarchy::packet_may_hit_children(const line_packet& packet, const wide_node& n,
+    const min_max<float> t)
+{
+    // Interval arithmetic over the origins and inverse directions of the packet: every ray enters
+    // a box no earlier than entry and leaves it no later than exit.
+    float4 entry{ t.min };
+    float4 exit{ t.max };
+    const std::array<const std::array<float, width>*, 3> mins = { &n.min_x, &n.min_y, &n.min_z };
+    const std::array<const std::array<float, width>*, 3> maxs = { &n.max_x, &n.max_y, &n.max_z };
+    for (int32_t axis = 0; axis < 3; ++axis)
+    {
+        const float4 origin_min{ packet.origin_bounds.min[axis] };
+        const float4 origin_max{ packet.origin_bounds.max[axis] };
+        const float4 inverse_min{ packet.inverse_direction_bounds.min[axis] };
+        const float4 inverse_max{ packet.inverse_direction_bounds.max[axis] };
+        const bool positive = packet.inverse_direction_bounds.min[axis] > 0.f;
+        const float4 near_plane = float4::load(positive ? mins[axis]->data() : maxs[axis]->data());
+        const float4 far_plane = float4::load(positive ? maxs[axis]->data() : mins[axis]->data());
+
+        const float4 near_a = (near_plane - origin_max) * inverse_min;
+        const float4 near_b = (near_plane - origin_max) * inverse_max;
+        const float4 near_c = (near_plane - origin_min) * inverse_min;
+        const float4 near_d = (near_plane - origin_min) * inverse_max;
+        entry = max(entry, min(min(near_a, near_b), min(near_c, near_d)));
+
+        const float4 far_a = (far_plane - origin_max) * inverse_min;
+        const float4 far_b = (far_plane - origin_max) * inverse_max;
+        const float4 far_c = (far_plane - origin_min) * inverse_min;
+        const float4 far_d = (far_plane - origin_min) * inverse_max;
+        exit = min(exit, max(max(far_a, far_b), max(far_c, far_d)));
+    }
+    return bits(entry <= exit);
+}
+
+uint32_t linear_bounding_volume_hierarchy::packet_hits_box(const line_packet& packet, const axis_aligned_bounding_box& box,
+    const float t_min, const std::array<float, line_packet::size>& t_max, std::array<float, line_packet::size>& entry_ts,
+    float& nearest)
+{
+    const float4 box_min_x{ box.min.x };
+    const float4 box_min_y{ box.min.y };
+    const float4 box_min_z{ box.min.z };
+    const float4 box_max_x{ box.max.x };
+    const float4 box_max_y{ box.max.y };
+    const float4 box_max_z{ box.max.z };
+    const float4 zero{ 0.f };
+
+    uint32_t lanes = 0;
+    for (uint32_t first = 0; first < line_packet::size; first += 4)
+    {
+        const float4 origin_x = float4::load(packet.origin_x.data() + first);
+        const float4 origin_y = float4::load(packet.origin_y.data() + first);
+        const float4 origin_z = float4::load(packet.origin_z.data() + first);
+        const float4 inverse_direction_x = float4::load(packet.inverse_direction_x.data() + first);
+        const float4 inverse_direction_y = float4::load(packet.inverse_direction_y.data() + first);
+        const float4 inverse_direction_z = float4::load(packet.inverse_direction_z.data() + first);
+
+        const float4 t0_x = (box_min_x - origin_x) * inverse_direction_x;
+        const float4 t1_x = (box_max_x - origin_x) * inverse_direction_x;
+        const float4 t0_y = (box_min_y - origin_y) * inverse_direction_y;
+        const float4 t1_y = (box_max_y - origin_y) * inverse_direction_y;
+        const float4 t0_z = (box_min_z - origin_z) * inverse_direction_z;
+        const float4 t1_z = (box_max_z - origin_z) * inverse_direction_z;
+
+        // The rays may point different ways, so the near plane of each slab is selected per lane.
+        const mask4 negative_x = inverse_direction_x < zero;
+        const mask4 negative_y = inverse_direction_y < zero;
+        const mask4 negative_z = inverse_direction_z < zero;
+        const float4 entry_t = max(select(negative_x, t1_x, t0_x),
+            max(select(negative_y, t1_y, t0_y), max(select(negative_z, t1_z, t0_z), float4{ t_min })));
+        const float4 exit_t = min(select(negative_x, t0_x, t1_x),
+            min(select(negative_y, t0_y, t1_y), min(select(negative_z, t0_z, t1_z), float4::load(t_max.data() + first))));
+
+        lanes |= bits(entry_t <= exit_t) << first;
+        entry_t.store(entry_ts.data() + first);
+    }
+
+    nearest = FLT_MAX;
+    for (uint32_t lane = 0; lane < line_packet::size; ++lane)
+    {
+        if (lanes & (1u << lane))
+        {
+            nearest = std::min(nearest, entry_ts[lane]);
+        }
+    }
+    return lanes;
+}
+
+uint32_t linear_bounding_volume_hierarchy::collapse(const uint32_t binary_index)
+{
+    // Open the interior slot with the largest box until all slots are used or only leaves remain,
+    // since the largest boxes are the ones most rays would otherwise have to visit one by one.
+    // Subtrees of a few balls are kept closed and become a single leaf for the batched test.
+    std::array<uint32_t, width> slots = { binary_index };
+    std::array<uint32_t, width> ball_counts = { this->ball_count(binary_index) };
+    uint32_t slot_count = 1;
+    while (slot_count < width)
+    {
+        uint32_t widest = width;
+        float widest_area = -1.f;
+        for (uint32_t i = 0; i < slot_count; ++i)
+        {
+            if (const node& n = this->nodes[slots[i]]; n.primitive_count == 0 && ball_counts[i] == 0 && n.box.surface_area() > widest_area)
+            {
+                widest = i;
+                widest_area = n.box.surface_area();
+            }
+        }
+        if (widest == width)
+        {
+            break;
+        }
+
+        const uint32_t opened = slots[widest];
+        slots[widest] = opened + 1;
+        ball_counts[widest] = this->ball_count(opened + 1);
+        slots[slot_count] = this->nodes[opened].offset;
+        ball_counts[slot_count++] = this->ball_count(this->nodes[opened].offset);
+    }
+
+    wide_node w;
+    w.min_x.fill(FLT_MAX);
+    w.min_y.fill(FLT_MAX);
+    w.min_z.fill(FLT_MAX);
+    w.max_x.fill(-FLT_MAX);
+    w.max_y.fill(-FLT_MAX);
+    w.max_z.fill(-FLT_MAX);
+    w.offset.fill(0);
+    w.primitive_count.fill(0);
+    w.ball_leaf.fill(0);
+
+    const uint32_t index = uint32_t(this->wide_nodes.size());
+    this->wide_nodes.emplace_back();
+    for (uint32_t i = 0; i < slot_count; ++i)
+    {
+        const node& n = this->nodes[slots[i]];
+        w.min_x[i] = n.box.min.x;
+        w.min_y[i] = n.box.min.y;
+        w.min_z[i] = n.box.min.z;
+        w.max_x[i] = n.box.max.x;
+        w.max_y[i] = n.box.max.y;
+        w.max_z[i] = n.box.max.z;
+        if (ball_counts[i] > 0)
+        {
+            w.offset[i] = this->first_primitive(slots[i]);
+            w.primitive_count[i] = uint16_t(ball_counts[i]);
+            w.ball_leaf[i] = 1;
+        }
+        else
+        {
+            w.offset[i] = n.primitive_count > 0 ? n.offset : this->collapse(slots[i]);
+            w.primitive_count[i] = n.primitive_count;
+        }
+    }
+    this->wide_nodes[index] = w;
+    return index;
+}
+
+uint32_t linear_bounding_volume_hierarchy::ball_count(const uint32_t binary_index) const
+{
+    const node& n = this->nodes[binary_index];
+    if (n.primitive_count > 0)
+    {
+        for (uint32_t p = n.offset; p < n.offset + n.primitive_count; ++p)
+        {
+            if (!this->balls.is_ball(p))
+            {
+                return 0;
+            }
+        }
+        return n.primitive_count;
+    }
+
+    // The primitives of both children are stored next to each other, so a subtree of balls is
+    // a contiguous range of them as well.
+    const uint32_t first = this->ball_count(binary_index + 1);
+    if (first == 0 || first >= ball_batch::lane_count)
+    {
+        return 0;
+    }
+    const uint32_t second = this->ball_count(n.offset);
+    return second > 0 && first + second <= ball_batch::lane_count ? first + second : 0;
+}
+
+uint32_t linear_bounding_volume_hierarchy::first_primitive(uint32_t binary_index) const
+{
+    while (this->nodes[binary_index].primitive_count == 0)
+    {
+        ++binary_index;
+    }
+    return this->nodes[binary_index].offset;
+}
+
+linear_bounding_volume_hierarchy::split linear_bounding_volume_hierarchy::find_split(
+    const std::vector<build_primitive>& build_primitives, const size_t begin, const size_t end,
+    const axis_aligned_bounding_box& box, const axis_aligned_bounding_box& centroid_box) const
+{
+    struct bin
+    {
+        axis_aligned_bounding_box box;
+        uint32_t count = 0;
+    };
+
+    const uint32_t bin_count = this->info.bin_count;
+    const float inverse_area = 1.f / std::max(box.surface_area(), FLT_MIN);
+
+    std::vector<bin> bins(bin_count);
+    std::vector<float> right_areas(bin_count);
+    std::vector<uint32_t> right_counts(bin_count);
+
+    split best{ 0, 0, FLT_MAX };
+    for (uint8_t axis = 0; axis < 3; ++axis)
+    {
+        const float axis_min = centroid_box.min[axis];
+        const float extent = centroid_box.max[axis] - axis_min;
+        if (extent <= 0.f)
+        {
+            continue;
+        }
+
+        std::fill(bins.begin(), bins.end(), bin{});
+        const float bin_scale = bin_count / extent;
+        for (size_t i = begin; i < end; ++i)
+        {
+            const uint32_t b = std::min(uint32_t((build_primitives[i].centroid[axis] - axis_min) * bin_scale), bin_count - 1);
+            bins[b].box = bins[b].count == 0
+                ? build_primitives[i].box
+                : axis_aligned_bounding_box::surrounding(bins[b].box, build_primitives[i].box);
+            ++bins[b].count;
+        }
+
+        // Sweep from the right to know the bounds of everything past every split plane...
+        axis_aligned_bounding_box right_box;
+        uint32_t right_count = 0;
+        for (uint32_t b = bin_count - 1; b > 0; --b)
+        {
+            if (bins[b].count > 0)
+            {
+                right_box = right_count == 0 ? bins[b].box : axis_aligned_bounding_box::surrounding(right_box, bins[b].box);
+                right_count += bins[b].count;
+            }
+            right_areas[b - 1] = right_count > 0 ? right_box.surface_area() : 0.f;
+            right_counts[b - 1] = right_count;
+        }
+
+        // ...and then from the left to evaluate them.
+        axis_aligned_bounding_box left_box;
+        uint32_t left_count = 0;
+        for (uint32_t b = 0; b + 1 < bin_count; ++b)
+        {
+            if (bins[b].count > 0)
+            {
+                left_box = left_count == 0 ? bins[b].box : axis_aligned_bounding_box::surrounding(left_box, bins[b].box);
+                left_count += bins[b].count;
+            }
+            if (left_count == 0 || right_counts[b] == 0)
+            {
+                continue;
+            }
+
+            const float cost = this->info.traversal_cost + this->info.intersection_cost * inverse_area
+                * (left_box.surface_area() * left_count + right_areas[b] * right_counts[b]);
+            if (cost < best.cost)
+            {
+                best = split{ axis, b, cost };
+            }
+        }
+    }
+    return best;
+}
\ No newline at end of file
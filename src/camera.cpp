@@ -1,7 +1,7 @@
 #include <camera.hpp>
 
 #include <line.hpp>
-#include <util/random.hpp>
+#include <math/sampling.hpp>
 
 camera::camera(const camera_create_info& info)
     : origin(info.camera_position)
@@ -21,13 +21,13 @@ camera::camera(const camera_create_info& info)
     this->vertical = 2.f * half_height * focus_distance * v;
 }
 
-line camera::shoot_ray_at(const float s, const float t) const
+line camera::shoot_ray_at(const float s, const float t, const glm::vec2& lens_sample, const float time_sample) const
 {
-    const displacement random_spot_on_lens = this->lens_radius * random_in_unit_disk();
-    const displacement offset = (this->u * random_spot_on_lens.x) + (this->v * random_spot_on_lens.y);
+    const displacement spot_on_lens = this->lens_radius * sample_unit_disk(lens_sample);
+    const displacement offset = (this->u * spot_on_lens.x) + (this->v * spot_on_lens.y);
     return line{
         this->origin + offset,
         this->lower_left_corner + (s * this->horizontal) + (t * this->vertical) - this->origin - offset,
-        random_uniform(this->time.min, this->time.max)
+        this->time.min + time_sample * (this->time.max - this->time.min)
     };
 }
\ No newline at end of file
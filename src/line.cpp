@@ -2,11 +2,12 @@
 
 #include <material.hpp>
 #include <math/sphere.hpp>
-#include <util/random.hpp>
 #include <render_plan.hpp>
+#include <sampler.hpp>
 
 #include <glm/gtc/constants.hpp>
 
+#include <algorithm>
 #include <cfloat>
 
 position line::point_at_parameter(const float t) const
@@ -14,22 +15,50 @@ position line::point_at_parameter(const float t) const
     return origin + t * direction;
 }
 
-color line::seen_color(const scene& world, const int32_t depth) const
+color line::seen_color(const scene& world, sample_stream& samples) const
 {
-    if (const hit_record_opt hit = world.hit(*this, min_max<float>{ 0.0001f, FLT_MAX }))
+    return this->seen_color(world, samples, world.hit(*this, hit_interval));
+}
+
+color line::seen_color(const scene& world, sample_stream& samples, const hit_record_opt& first_hit) const
+{
+    color radiance{ 0.f };
+    color throughput{ 1.f };
+    line ray = *this;
+    for (int32_t depth = 0; ; ++depth)
     {
-        if (hit->p_material)
+        const hit_record_opt hit = depth == 0 ? first_hit : world.hit(ray, hit_interval);
+        if (!hit || hit->material.type == material_type::none)
         {
-            const color emitted = hit->p_material->emitted(hit->uv, hit->point);
-            if (depth < 50)
+            const position sky_point = ray.origin + ray.direction;
+            radiance += throughput * world.value_at(world.sky, uv_on_sphere(glm::normalize(ray.direction)), sky_point);
+            break;
+        }
+
+        radiance += throughput * world.emitted(*hit);
+        if (depth >= max_depth)
+        {
+            break;
+        }
+
+        const scattering_opt s = world.scatter(ray, *hit, samples);
+        if (!s)
+        {
+            break;
+        }
+        throughput *= s->attenuation;
+
+        if (depth >= russian_roulette_depth)
+        {
+            const float survival = std::min(1.f, std::max({ throughput.r, throughput.g, throughput.b }));
+            if (samples.next_1d() >= survival)
             {
-                if (const scattering_opt s = hit->p_material->scatter(*this, *hit))
-                {
-                    return emitted + s->attenuation * s->scattered_ray.seen_color(world, depth + 1);
-                }
+                break;
             }
-            return emitted;
+            throughput /= survival;
         }
+
+        ray = s->scattered_ray;
     }
-    return world.sky->value_at(uv_on_sphere(glm::normalize(this->direction)), this->origin + this->direction);
+    return radiance;
 }
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include <line_packet.hpp>
+
+#include <cfloat>
+#include <stdexcept>
+
+void line_packet::add(const line& ray)
+{
+    if (this->line_count == size)
+    {
+        throw std::runtime_error{ "line_packet: The packet is full." };
+    }
+
+    const uint32_t i = this->line_count++;
+    this->lines[i].emplace(ray);
+    this->origin_x[i] = ray.origin.x;
+    this->origin_y[i] = ray.origin.y;
+    this->origin_z[i] = ray.origin.z;
+    this->inverse_direction_x[i] = ray.inverse_direction.x;
+    this->inverse_direction_y[i] = ray.inverse_direction.y;
+    this->inverse_direction_z[i] = ray.inverse_direction.z;
+
+    if (i == 0)
+    {
+        this->origin_bounds = { ray.origin, ray.origin };
+        this->inverse_direction_bounds = { ray.inverse_direction, ray.inverse_direction };
+    }
+    else
+    {
+        this->origin_bounds = { glm::min(this->origin_bounds.min, ray.origin), glm::max(this->origin_bounds.max, ray.origin) };
+        this->inverse_direction_bounds = {
+            glm::min(this->inverse_direction_bounds.min, ray.inverse_direction),
+            glm::max(this->inverse_direction_bounds.max, ray.inverse_direction) };
+    }
+}
+
+uint32_t line_packet::count() const
+{
+    return this->line_count;
+}
+
+const line& line_packet::operator[](const uint32_t i) const
+{
+    return *this->lines[i];
+}
+
+uint32_t line_packet::active_mask() const
+{
+    return (1u << this->line_count) - 1u;
+}
+
+bool line_packet::is_coherent() const
+{
+    if (this->line_count == 0)
+    {
+        return false;
+    }
+
+    const displacement& low = this->inverse_direction_bounds.min;
+    const displacement& high = this->inverse_direction_bounds.max;
+    for (int32_t axis = 0; axis < 3; ++axis)
+    {
+        const bool positive = low[axis] > 0.f && high[axis] < FLT_MAX;
+        const bool negative = high[axis] < 0.f && low[axis] > -FLT_MAX;
+        if (!positive && !negative)
+        {
+            return false;
+        }
+    }
+    return true;
+}
\ No newline at end of file
@@ -1,18 +1,15 @@
 #define VULKAN_TEST 1
 
-#if VULKAN_TEST
-#   include <renderer/vulkan.hpp>
-#   include <scene_definitions_for_vulkan/render_plan.hpp>
-#else
-#   include <render_plan.hpp>
-#   include <renderer/cpu.hpp>
-#endif
+#include <render_plan.hpp>
+#include <renderer/cpu.hpp>
+#include <renderer/vulkan.hpp>
 #include <util/string.hpp>
 #include <util/sizes.hpp>
 
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
 
+#include <chrono>
 #include <iostream>
 #include <string>
 
@@ -50,11 +47,21 @@ int main()
     try
     {
         const extent_2d<uint32_t> image_size = { 1600, 900 };
+        // Both renderers take the same plans, but the Vulkan one only shades lambertian materials.
+#if VULKAN_TEST
+        render_plan plan = render_plan::hello_ball(image_size);
+#else
+        render_plan plan = render_plan::random_balls(image_size);
+#endif
+
+        std::cout << "Building acceleration structure... ";
+        const std::chrono::steady_clock::duration build_time = plan.world.build_acceleration(plan.shutter);
+        std::cout << "Done (" << std::chrono::duration_cast<std::chrono::milliseconds>(build_time).count() << " ms, SAH cost "
+            << plan.world.acceleration_sah_cost() << ")." << std::endl;
+
 #if VULKAN_TEST
-        const render_plan plan = render_plan::hello_ball(image_size);
         const std::vector<rgba> image = vulkan_renderer{ 1000 }.render_scene(plan);
 #else
-        const render_plan plan = render_plan::random_balls(image_size);
         const std::vector<rgba> image = cpu_renderer{ 1000, 20 }.render_scene(plan);
 #endif
         export_image(image, image_size, "test.png");
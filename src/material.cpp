@@ -1,6 +0,0 @@
-#include <material.hpp>
-
-color material::emitted(const std::pair<float, float>, const position&) const
-{
-    return color{};
-}
\ No newline at end of file
@@ -1,23 +1,16 @@
 #include <material/dielectric.hpp>
 
 #include <hittable.hpp>
-#include <texture/constant.hpp>
-#include <util/random.hpp>
+#include <sampler.hpp>
 #include <util/vector_types.hpp>
 
-dielectric::dielectric(const color& albedo, const float refractive_index)
+dielectric::dielectric(const texture& albedo, const float refractive_index)
     : refractive_index(refractive_index)
-    , albedo(std::make_unique<constant_texture>(albedo))
+    , albedo(albedo)
 {
 }
 
-dielectric::dielectric(unique_texture&& albedo, const float refractive_index)
-    : refractive_index(refractive_index)
-    , albedo(std::move(albedo))
-{
-}
-
-scattering_opt dielectric::scatter(const line& ray, const hit_record& hit) const
+scattering_opt dielectric::scatter(const line& ray, const hit_record& hit, const color& albedo, sample_stream& samples) const
 {
     const float direction_dot_normal = glm::dot(ray.direction, hit.normal);
     const float direction_length = glm::length(ray.direction);
@@ -33,16 +26,15 @@ scattering_opt dielectric::scatter(const line& ray, const hit_record& hit) const
         ? schlick(cosine, this->refractive_index)
         : 1.f;
 
-    const color col = this->albedo->value_at(hit.uv, hit.point);
-    if (random_chance(reflect_probability))
+    if (samples.next_1d() < reflect_probability)
     {
-        return scattering{ col, line{ hit.point, reflected, ray.time } };
+        return scattering{ albedo, line{ hit.point, reflected, ray.time } };
     }
-    return scattering{ col, line{ hit.point, refracted, ray.time } };
+    return scattering{ albedo, line{ hit.point, refracted, ray.time } };
 }
 
 float dielectric::schlick(const float cosine, const float refractive_index)
 {
     const float r0 = glm::pow((1 - refractive_index) / (1 + refractive_index), 2);
     return r0 + (1 - r0) * glm::pow(1 - cosine, 5);
-}
+}
\ No newline at end of file
@@ -1,31 +1,20 @@
 #include <material/lambertian.hpp>
 
 #include <hittable.hpp>
+#include <math/sampling.hpp>
+#include <sampler.hpp>
 #include <shape/ball.hpp>
-#include <texture/constant.hpp>
-#include <util/random.hpp>
 
-#include <stdexcept>
-
-lambertian::lambertian(const color& albedo)
-    : albedo(std::make_unique<constant_texture>(albedo))
-{
-}
-
-lambertian::lambertian(unique_texture&& albedo)
-    : albedo(std::move(albedo))
+lambertian::lambertian(const texture& albedo)
+    : albedo(albedo)
 {
-    if (!this->albedo)
-    {
-        throw std::runtime_error{ "lambertian: Given texture should not be null." };
-    }
 }
 
-scattering_opt lambertian::scatter(const line& ray, const hit_record& hit) const
+scattering_opt lambertian::scatter(const line& ray, const hit_record& hit, const color& albedo, sample_stream& samples) const
 {
-    const position target = hit.point + hit.normal + random_direction();
+    const position target = hit.point + hit.normal + sample_unit_ball(samples.next_2d(), samples.next_1d());
     return scattering{
-        this->albedo->value_at(hit.uv, hit.point),
+        albedo,
         line{ hit.point, target - hit.point, ray.time }
     };
 }
\ No newline at end of file
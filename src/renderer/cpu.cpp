@@ -1,79 +1,334 @@
 #include <renderer/cpu.hpp>
 
 #include <line.hpp>
+#include <line_packet.hpp>
 #include <util/colors.hpp>
 #include <util/random.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <condition_variable>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
 
-cpu_renderer::cpu_renderer(const uint32_t sample_count, const uint32_t thread_count)
+cpu_renderer::cpu_renderer(const uint32_t sample_count, const uint32_t thread_count, const thread_affinity affinity)
     : sample_count(sample_count)
-    , thread_count(thread_count)
+    , workers(thread_count, affinity)
 {
+    this->reporter = std::thread{ &cpu_renderer::report, this };
+}
+
+cpu_renderer::~cpu_renderer()
+{
+    {
+        std::lock_guard lock{ this->reporter_mtx };
+        this->reporter_stopping = true;
+    }
+    this->reporter_wake.notify_one();
+    this->reporter.join();
 }
 
 std::vector<rgba> cpu_renderer::render_scene(const render_plan& plan)
 {
-    const uint32_t fragment_height = plan.image_size.height / this->thread_count;
+    std::vector<rgba> image(size_t(plan.image_size.width) * size_t(plan.image_size.height));
+    this->render_scene(plan, image.data());
+    return image;
+}
 
-    std::cout << "Starting jobs... ";
+void cpu_renderer::render_scene(const render_plan& plan, rgba* image, uint32_t* sample_counts)
+{
+    const uint32_t width = plan.image_size.width;
+    const uint32_t height = plan.image_size.height;
 
-    std::vector<std::future<std::vector<rgba>>> image_fragments{ this->thread_count };
-    for (uint32_t i = 0; i < image_fragments.size(); ++i)
+    if (!plan.world.is_acceleration_built())
     {
-        image_fragments[i] = std::async(std::launch::async, &cpu_renderer::render_fragment, this,
-            &plan, glm::uvec2{ 0, i * fragment_height },
-            glm::uvec2{ plan.image_size.width, (i + 1) * fragment_height });
+        throw std::runtime_error{ "cpu_renderer: The acceleration structure of the scene has not been built or updated since objects were added." };
     }
 
-    std::cout << "Done." << std::endl;
-    std::cout << "Rendering image fragments... 0.00%";
+    const unique_sampler pixel_sampler = make_sampler(plan.sampling, this->sample_count, plan.seed);
+    std::vector<work_stealing_pool::job> tiles;
+    for (uint32_t y = 0; y < height; y += tile_size)
+    {
+        for (uint32_t x = 0; x < width; x += tile_size)
+        {
+            const glm::uvec2 top_left = { x, y };
+            const glm::uvec2 bottom_right = { std::min(x + tile_size, width), std::min(y + tile_size, height) };
+            tiles.push_back([this, &plan, &pixel_sampler, image, sample_counts, top_left, bottom_right]
+            {
+                if (this->adaptive.enabled)
+                {
+                    this->render_fragment_adaptively(&plan, pixel_sampler.get(), image, sample_counts, top_left, bottom_right);
+                }
+                else
+                {
+                    this->render_fragment(&plan, pixel_sampler.get(), image, sample_counts, top_left, bottom_right);
+                }
+            });
+        }
+    }
+
+    this->rendered_pixels = 0;
+    this->total_pixels = uint64_t(width) * uint64_t(height);
+    this->render_start = std::chrono::steady_clock::now();
 
-    this->progress = 0.f;
-    std::vector<rgba> image;
-    for (uint32_t i = 0; i < image_fragments.size(); ++i)
+    const auto set_frame_running = [this](const bool running)
     {
-        const std::vector<rgba> fragment = image_fragments[i].get();
-        image.insert(image.end(), fragment.begin(), fragment.end());
+        {
+            std::lock_guard lock{ this->reporter_mtx };
+            this->frame_running = running;
+        }
+        this->reporter_wake.notify_one();
+    };
+
+    set_frame_running(true);
+    try
+    {
+        this->workers.run(std::move(tiles));
+    }
+    catch (...)
+    {
+        set_frame_running(false);
+        throw;
     }
 
-    std::cout << "\rRendering image fragments... Done.  " << std::endl;
-    return image;
+    set_frame_running(false);
+    if (this->on_progress)
+    {
+        this->on_progress(this->progress());
+    }
+}
+
+void cpu_renderer::set_adaptive_sampling(const adaptive_sampling& settings)
+{
+    if (settings.batch_size == 0)
+    {
+        throw std::runtime_error{ "cpu_renderer: Adaptive sampling batch size should be greater than zero." };
+    }
+    this->adaptive = settings;
+}
+
+void cpu_renderer::set_progress_callback(progress_callback callback, const std::chrono::milliseconds interval)
+{
+    this->on_progress = std::move(callback);
+    this->progress_interval = interval;
+}
+
+render_progress cpu_renderer::progress() const
+{
+    // An empty frame is finished as soon as it starts.
+    const uint64_t total = this->total_pixels;
+    const float fraction = total != 0 ? float(double(this->rendered_pixels) / double(total)) : 1.f;
+    const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - this->render_start.load();
+    const std::chrono::steady_clock::duration remaining = fraction > 0.f
+        ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(elapsed * ((1.f - fraction) / fraction))
+        : std::chrono::steady_clock::duration::zero();
+    return render_progress{ fraction, elapsed, remaining };
+}
+
+void cpu_renderer::report()
+{
+    std::unique_lock lock{ this->reporter_mtx };
+    while (true)
+    {
+        this->reporter_wake.wait(lock, [this] { return this->reporter_stopping || this->frame_running; });
+        if (this->reporter_stopping)
+        {
+            return;
+        }
+
+        while (!this->reporter_wake.wait_for(lock, this->progress_interval,
+            [this] { return this->reporter_stopping || !this->frame_running; }))
+        {
+            if (this->on_progress)
+            {
+                this->on_progress(this->progress());
+            }
+        }
+    }
+}
+
+void cpu_renderer::print_progress(const render_progress& progress)
+{
+    if (progress.fraction < 1.f)
+    {
+        std::cout << "\rRendering image fragments... " << std::fixed << std::setprecision(2) << 100.f * progress.fraction
+            << "% (" << std::chrono::duration_cast<std::chrono::seconds>(progress.estimated_remaining).count() << "s left)   "
+            << std::flush;
+    }
+    else
+    {
+        std::cout << "\rRendering image fragments... Done.                " << std::endl;
+    }
+}
+
+void cpu_renderer::render_fragment(const render_plan* plan, const sampler* pixel_sampler, rgba* image,
+    uint32_t* sample_counts, const glm::uvec2 top_left, const glm::uvec2 bottom_right)
+{
+    const uint32_t width = bottom_right.x - top_left.x;
+    for (uint32_t y = top_left.y; y < bottom_right.y; ++y)
+    {
+        for (uint32_t x = top_left.x; x < bottom_right.x; x += line_packet::size)
+        {
+            const uint32_t pixel_count = std::min(line_packet::size, bottom_right.x - x);
+            std::array<pixel_estimate, line_packet::size> estimates;
+            this->trace_packets(plan, pixel_sampler, glm::uvec2{ x, y }, pixel_count, 0, this->sample_count, estimates.data());
+            for (uint32_t i = 0; i < pixel_count; ++i)
+            {
+                store_pixel(plan, image, sample_counts, glm::uvec2{ x + i, y }, estimates[i]);
+            }
+        }
+
+        this->rendered_pixels.fetch_add(width, std::memory_order_relaxed);
+    }
 }
 
-std::vector<rgba> cpu_renderer::render_fragment(const render_plan* plan, const glm::uvec2 top_left, const glm::uvec2 bottom_right)
+void cpu_renderer::render_fragment_adaptively(const render_plan* plan, const sampler* pixel_sampler, rgba* image,
+    uint32_t* sample_counts, const glm::uvec2 top_left, const glm::uvec2 bottom_right)
 {
     const uint32_t width = bottom_right.x - top_left.x;
     const uint32_t height = bottom_right.y - top_left.y;
-    const float inverse_image_width = 1.f / plan->image_size.width;
-    const float inverse_image_height = 1.f / plan->image_size.height;
-    const float inverse_sample_count = 1.f / sample_count;
+    const auto pixel_at = [&](const size_t i) { return top_left + glm::uvec2{ uint32_t(i % width), uint32_t(i / width) }; };
 
-    std::vector<rgba> image_fragment;
-    image_fragment.reserve(size_t(width) * size_t(height));
+    const uint32_t first_pass = std::min(std::max(this->adaptive.min_sample_count, 2u), this->sample_count);
+    const uint32_t max_per_pixel = std::max(uint32_t(this->sample_count * this->adaptive.max_sample_factor), first_pass);
 
-    for (uint32_t y = top_left.y; y < bottom_right.y; ++y)
+    std::vector<pixel_estimate> estimates(size_t(width) * size_t(height));
+    uint64_t budget = uint64_t(this->sample_count) * estimates.size();
+    for (uint32_t y = 0; y < height; ++y)
     {
-        for (uint32_t x = top_left.x; x < bottom_right.x; ++x)
+        for (uint32_t x = 0; x < width; x += line_packet::size)
         {
-            color col{ 0.f };
-            for (uint32_t s = 0; s < sample_count; ++s)
+            const uint32_t pixel_count = std::min(line_packet::size, width - x);
+            this->trace_packets(plan, pixel_sampler, top_left + glm::uvec2{ x, y }, pixel_count, 0, first_pass,
+                &estimates[size_t(y) * width + x]);
+        }
+    }
+    budget -= uint64_t(first_pass) * estimates.size();
+
+    std::vector<std::pair<float, size_t>> unconverged;
+    while (budget > 0)
+    {
+        unconverged.clear();
+        for (size_t i = 0; i < estimates.size(); ++i)
+        {
+            if (const float error = estimates[i].standard_error();
+                estimates[i].count < max_per_pixel && error > this->adaptive.error_threshold)
             {
-                const float u = float(x + random_uniform<float>()) * inverse_image_width;
-                const float v = float(plan->image_size.height - y + random_uniform<float>()) * inverse_image_height;
-                const line ray = plan->cam.shoot_ray_at(u, v);
-                col += ray.seen_color(plan->world);
+                unconverged.emplace_back(error, i);
             }
-            col *= inverse_sample_count;
-            col = { glm::sqrt(col.r), glm::sqrt(col.g), glm::sqrt(col.b) };
+        }
+        if (unconverged.empty())
+        {
+            break;
+        }
 
-            image_fragment.push_back(rgba{ to_rgb(col), 255 });
+        // The noisiest pixels go first, so they are the ones refined when the budget runs out.
+        std::sort(unconverged.begin(), unconverged.end(), std::greater<>{});
+        for (const auto& [error, i] : unconverged)
+        {
+            const uint32_t count = uint32_t(std::min<uint64_t>(
+                std::min(this->adaptive.batch_size, max_per_pixel - estimates[i].count), budget));
+            if (count == 0)
+            {
+                break;
+            }
+            this->trace_samples(plan, pixel_sampler, pixel_at(i), estimates[i].count, count, estimates[i]);
+            budget -= count;
         }
+    }
+
+    for (size_t i = 0; i < estimates.size(); ++i)
+    {
+        store_pixel(plan, image, sample_counts, pixel_at(i), estimates[i]);
+    }
+    this->rendered_pixels.fetch_add(estimates.size(), std::memory_order_relaxed);
+}
 
-        std::lock_guard lock{ this->progress_mtx };
-        this->progress += 100.f * inverse_image_height;
-        std::cout << "\rRendering image fragments... " << std::fixed << std::setprecision(2) << this->progress << "%";
+void cpu_renderer::trace_samples(const render_plan* plan, const sampler* pixel_sampler, const glm::uvec2 pixel,
+    const uint32_t first_sample, const uint32_t count, pixel_estimate& estimate) const
+{
+    for (uint32_t s = first_sample; s < first_sample + count; ++s)
+    {
+        sample_stream samples{ *pixel_sampler, pixel, s };
+        const line ray = camera_ray(plan, pixel, samples);
+        estimate.add(ray.seen_color(plan->world, samples));
     }
-    return image_fragment;
+}
+
+void cpu_renderer::trace_packets(const render_plan* plan, const sampler* pixel_sampler, const glm::uvec2 first_pixel,
+    const uint32_t pixel_count, const uint32_t first_sample, const uint32_t count, pixel_estimate* estimates) const
+{
+    for (uint32_t s = first_sample; s < first_sample + count; ++s)
+    {
+        std::array<std::optional<sample_stream>, line_packet::size> samples;
+        line_packet packet;
+        for (uint32_t i = 0; i < pixel_count; ++i)
+        {
+            const glm::uvec2 pixel = first_pixel + glm::uvec2{ i, 0 };
+            samples[i].emplace(*pixel_sampler, pixel, s);
+            packet.add(camera_ray(plan, pixel, *samples[i]));
+        }
+
+        std::array<hit_record_opt, line_packet::size> hits;
+        plan->world.hit(packet, line::hit_interval, hits);
+        for (uint32_t i = 0; i < pixel_count; ++i)
+        {
+            estimates[i].add(packet[i].seen_color(plan->world, *samples[i], hits[i]));
+        }
+    }
+}
+
+line cpu_renderer::camera_ray(const render_plan* plan, const glm::uvec2 pixel, sample_stream& samples)
+{
+    const glm::vec2 pixel_offset = samples.next_2d();
+    const float u = float(pixel.x + pixel_offset.x) * (1.f / plan->image_size.width);
+    const float v = float(plan->image_size.height - pixel.y + pixel_offset.y) * (1.f / plan->image_size.height);
+    const glm::vec2 lens_sample = samples.next_2d();
+    return plan->cam.shoot_ray_at(u, v, lens_sample, samples.next_1d());
+}
+
+void cpu_renderer::store_pixel(const render_plan* plan, rgba* image, uint32_t* sample_counts, const glm::uvec2 pixel,
+    const pixel_estimate& estimate)
+{
+    const size_t index = size_t(pixel.y) * plan->image_size.width + pixel.x;
+
+    color col = estimate.sum / float(estimate.count);
+    col = { glm::sqrt(col.r), glm::sqrt(col.g), glm::sqrt(col.b) };
+    image[index] = rgba{ to_rgb(col), 255 };
+
+    if (sample_counts)
+    {
+        sample_counts[index] = estimate.count;
+    }
+}
+
+void cpu_renderer::pixel_estimate::add(const color& sample)
+{
+    this->sum += sample;
+    ++this->count;
+
+    const float l = luminance(sample);
+    const float delta = l - this->luminance_mean;
+    this->luminance_mean += delta / float(this->count);
+    this->luminance_m2 += delta * (l - this->luminance_mean);
+}
+
+float cpu_renderer::pixel_estimate::standard_error() const
+{
+    if (this->count < 2)
+    {
+        return FLT_MAX;
+    }
+
+    // The image is stored as sqrt(color), so the error is scaled by the derivative of sqrt to
+    // measure it in displayed units, where dark pixels need far fewer samples than bright ones.
+    const float variance = this->luminance_m2 / float(this->count - 1);
+    const float linear_error = glm::sqrt(variance / float(this->count));
+    return linear_error / (2.f * glm::sqrt(std::max(this->luminance_mean, 1e-4f)));
 }
\ No newline at end of file
@@ -1,7 +1,7 @@
 #define VMA_IMPLEMENTATION
 
+#include <render_plan.hpp>
 #include <renderer/vulkan.hpp>
-#include <scene_definitions_for_vulkan/render_plan.hpp>
 #include <util/string.hpp>
 #include <util/vk_single_time_commands.hpp>
 
@@ -457,7 +457,7 @@ vk::UniqueShaderModule vulkan_renderer::load_shader_module(const std::string_vie
     file.close();
 
     string_replace_all(code, "@SCENE_SHAPES_COUNT@", std::to_string(plan.world.shapes.size()));
-    string_replace_all(code, "@SCENE_SPHERE_SHAPES_COUNT@", std::to_string(plan.world.sphere_shapes.size()));
+    string_replace_all(code, "@SCENE_BALLS_COUNT@", std::to_string(plan.world.balls.size()));
     string_replace_all(code, "@SCENE_DIELECTRIC_MATERIALS_COUNT@", std::to_string(plan.world.dielectric_materials.size()));
     string_replace_all(code, "@SCENE_DIFFUSE_LIGHT_MATERIALS_COUNT@", std::to_string(plan.world.diffuse_light_materials.size()));
     string_replace_all(code, "@SCENE_LAMBERTIAN_MATERIALS_COUNT@", std::to_string(plan.world.lambertian_materials.size()));
@@ -0,0 +1,43 @@
+#include <sampler.hpp>
+
+#include <sampler/halton.hpp>
+#include <sampler/independent.hpp>
+#include <sampler/sobol.hpp>
+#include <sampler/stratified.hpp>
+
+#include <stdexcept>
+
+unique_sampler make_sampler(const sampler_type type, const uint32_t samples_per_pixel, const uint64_t seed)
+{
+    switch (type)
+    {
+    case sampler_type::independent:
+        return std::make_unique<independent_sampler>(seed);
+    case sampler_type::stratified:
+        return std::make_unique<stratified_sampler>(samples_per_pixel, seed);
+    case sampler_type::halton:
+        return std::make_unique<halton_sampler>(seed);
+    case sampler_type::sobol:
+        return std::make_unique<sobol_sampler>(seed);
+    }
+    throw std::runtime_error{ "make_sampler: Unknown sampler type." };
+}
+
+sample_stream::sample_stream(const sampler& source, const glm::uvec2 pixel, const uint32_t sample_index)
+    : source(&source)
+    , pixel(pixel)
+    , sample_index(sample_index)
+{
+}
+
+float sample_stream::next_1d()
+{
+    return this->source->sample_1d(this->pixel, this->sample_index, this->dimension++);
+}
+
+glm::vec2 sample_stream::next_2d()
+{
+    const glm::vec2 sample = this->source->sample_2d(this->pixel, this->sample_index, this->dimension);
+    this->dimension += 2;
+    return sample;
+}
\ No newline at end of file
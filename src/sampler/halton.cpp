@@ -0,0 +1,42 @@
+#include <sampler/halton.hpp>
+
+halton_sampler::halton_sampler(const uint64_t seed)
+    : seed(seed)
+    , fallback(mix_seed(seed, 1))
+{
+}
+
+float halton_sampler::sample_1d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const
+{
+    if (dimension >= primes.size())
+    {
+        return this->fallback.sample_1d(pixel, sample_index, dimension);
+    }
+
+    const float rotation = bits_to_unit_float(uint32_t(pixel_dimension_seed(this->seed, pixel, dimension)));
+    const float value = radical_inverse(primes[dimension], sample_index) + rotation;
+    return std::min(value < 1.f ? value : value - 1.f, 1.f - FLT_EPSILON);
+}
+
+glm::vec2 halton_sampler::sample_2d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const
+{
+    return glm::vec2{
+        this->sample_1d(pixel, sample_index, dimension),
+        this->sample_1d(pixel, sample_index, dimension + 1) };
+}
+
+float halton_sampler::radical_inverse(const uint32_t base, uint32_t index)
+{
+    const double inverse_base = 1.0 / base;
+    double inverse_base_power = 1.0;
+    uint64_t reversed_digits = 0;
+    while (index != 0)
+    {
+        const uint32_t next = index / base;
+        const uint32_t digit = index - next * base;
+        reversed_digits = reversed_digits * base + digit;
+        inverse_base_power *= inverse_base;
+        index = next;
+    }
+    return std::min(float(double(reversed_digits) * inverse_base_power), 1.f - FLT_EPSILON);
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#include <sampler/independent.hpp>
+
+independent_sampler::independent_sampler(const uint64_t seed)
+    : seed(seed)
+{
+}
+
+float independent_sampler::sample_1d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const
+{
+    const uint64_t bits = mix_seed(pixel_dimension_seed(this->seed, pixel, dimension), sample_index);
+    return bits_to_unit_float(uint32_t(bits >> 32u));
+}
+
+glm::vec2 independent_sampler::sample_2d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const
+{
+    const uint64_t bits = mix_seed(pixel_dimension_seed(this->seed, pixel, dimension), sample_index);
+    return glm::vec2{ bits_to_unit_float(uint32_t(bits)), bits_to_unit_float(uint32_t(bits >> 32u)) };
+}
\ No newline at end of file
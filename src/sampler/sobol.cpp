@@ -0,0 +1,57 @@
+#include <sampler/sobol.hpp>
+
+sobol_sampler::sobol_sampler(const uint64_t seed)
+    : seed(seed)
+{
+}
+
+float sobol_sampler::sample_1d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const
+{
+    const uint64_t scramble = pixel_dimension_seed(this->seed, pixel, dimension);
+    const uint32_t shuffled_index = nested_uniform_scramble(sample_index, uint32_t(scramble));
+    return bits_to_unit_float(nested_uniform_scramble(reverse_bits(shuffled_index), uint32_t(scramble >> 32u)));
+}
+
+glm::vec2 sobol_sampler::sample_2d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const
+{
+    const uint64_t scramble = pixel_dimension_seed(this->seed, pixel, dimension);
+    const uint32_t shuffled_index = nested_uniform_scramble(sample_index, uint32_t(scramble));
+    return glm::vec2{
+        bits_to_unit_float(nested_uniform_scramble(reverse_bits(shuffled_index), uint32_t(scramble >> 32u))),
+        bits_to_unit_float(nested_uniform_scramble(sobol_second_dimension(shuffled_index), uint32_t(mix_seed(scramble, 1)))) };
+}
+
+uint32_t sobol_sampler::reverse_bits(uint32_t x)
+{
+    x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+    x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+    x = ((x >> 4) & 0x0f0f0f0fu) | ((x & 0x0f0f0f0fu) << 4);
+    x = ((x >> 8) & 0x00ff00ffu) | ((x & 0x00ff00ffu) << 8);
+    return (x >> 16) | (x << 16);
+}
+
+uint32_t sobol_sampler::nested_uniform_scramble(const uint32_t x, const uint32_t seed)
+{
+    // Laine-Karras permutation applied to the reversed bits, so that every bit only depends
+    // on the bits more significant than itself.
+    uint32_t v = reverse_bits(x);
+    v += seed;
+    v ^= v * 0x6c50b47cu;
+    v ^= v * 0xb82f1e52u;
+    v ^= v * 0xc7afe638u;
+    v ^= v * 0x8d22f6e6u;
+    return reverse_bits(v);
+}
+
+uint32_t sobol_sampler::sobol_second_dimension(uint32_t index)
+{
+    uint32_t result = 0;
+    for (uint32_t direction = 1u << 31; index != 0; index >>= 1, direction ^= direction >> 1)
+    {
+        if (index & 1u)
+        {
+            result ^= direction;
+        }
+    }
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include <sampler/stratified.hpp>
+
+stratified_sampler::stratified_sampler(const uint32_t samples_per_pixel, const uint64_t seed)
+    : seed(seed)
+    , strata_count(std::max(samples_per_pixel, 1u))
+    , jitter(mix_seed(seed, 1))
+{
+    // The grid has exactly one cell per sample, as square as the factors of the count allow, so
+    // that the samples of a pixel cover every cell.
+    this->strata_grid.x = std::max(uint32_t(glm::sqrt(float(this->strata_count))), 1u);
+    while (this->strata_count % this->strata_grid.x != 0)
+    {
+        --this->strata_grid.x;
+    }
+    this->strata_grid.y = this->strata_count / this->strata_grid.x;
+}
+
+float stratified_sampler::sample_1d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const
+{
+    const uint32_t scramble = uint32_t(pixel_dimension_seed(this->seed, pixel, dimension));
+    const uint32_t stratum = permute(sample_index % this->strata_count, this->strata_count, scramble);
+    const float offset = this->jitter.sample_1d(pixel, sample_index, dimension);
+    return std::min((float(stratum) + offset) / float(this->strata_count), 1.f - FLT_EPSILON);
+}
+
+glm::vec2 stratified_sampler::sample_2d(const glm::uvec2 pixel, const uint32_t sample_index, const uint32_t dimension) const
+{
+    const uint32_t scramble = uint32_t(pixel_dimension_seed(this->seed, pixel, dimension));
+    const uint32_t cell = permute(sample_index % this->strata_count, this->strata_count, scramble);
+    const glm::vec2 offset = this->jitter.sample_2d(pixel, sample_index, dimension);
+    return glm::vec2{
+        std::min((float(cell % this->strata_grid.x) + offset.x) / float(this->strata_grid.x), 1.f - FLT_EPSILON),
+        std::min((float(cell / this->strata_grid.x) + offset.y) / float(this->strata_grid.y), 1.f - FLT_EPSILON) };
+}
+
+// Kensler, "Correlated Multi-Jittered Sampling", 2013: a hashed permutation of [0, length).
+uint32_t stratified_sampler::permute(uint32_t i, const uint32_t length, const uint32_t seed)
+{
+    uint32_t mask = length - 1;
+    mask |= mask >> 1;
+    mask |= mask >> 2;
+    mask |= mask >> 4;
+    mask |= mask >> 8;
+    mask |= mask >> 16;
+    do
+    {
+        i ^= seed;
+        i *= 0xe170893du;
+        i ^= seed >> 16;
+        i ^= (i & mask) >> 4;
+        i ^= seed >> 8;
+        i *= 0x0929eb3fu;
+        i ^= seed >> 23;
+        i ^= (i & mask) >> 1;
+        i *= 1 | seed >> 27;
+        i *= 0x6935fa69u;
+        i ^= (i & mask) >> 11;
+        i *= 0x74dcb303u;
+        i ^= (i & mask) >> 2;
+        i *= 0x9e501cc3u;
+        i ^= (i & mask) >> 2;
+        i *= 0xc860a3dfu;
+        i &= mask;
+        i ^= i >> 5;
+    } while (i >= length);
+    return (i + seed) % length;
+}
\ No newline at end of file
@@ -1,19 +1,344 @@
 #include <scene.hpp>
 
-#include <bounding_volume_hierarchy/bounding_volume_hierarchy_node.hpp>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
 
-scene::scene(unique_texture&& sky)
-    : sky(std::move(sky))
+scene::scene()
 {
+    this->sky = this->add_texture(constant_texture(color{ 1.f }));
 }
 
-hit_record_opt scene::hit(const line& ray, const min_max<float> t) const
+shape scene::add_shape(const ball& in_shape)
 {
-    static const bounding_volume_hierarchy_node bvh = { this->hittables, t };
-    return bvh.hit(ray, t);
+    this->balls.push_back(in_shape);
+    this->shapes.push_back(shape{ shape_type::ball, array_index(this->balls.size() - 1) });
+    // The hierarchy points into the arrays, which may have moved. It is rebuilt once, on the next
+    // update, however many objects are added until then.
+    this->bvh.reset();
+    return this->shapes.back();
+}
+
+std::chrono::steady_clock::duration scene::build_acceleration(const min_max<float> time,
+    const bounding_volume_hierarchy_create_info& info)
+{
+    this->acceleration_time = time;
+    this->acceleration_info = info;
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    this->rebuild_acceleration();
+    return std::chrono::steady_clock::now() - start;
+}
+
+bool scene::update_acceleration(const min_max<float> time)
+{
+    this->acceleration_time = time;
+    if (!this->bvh)
+    {
+        this->rebuild_acceleration();
+        return true;
+    }
+
+    this->bvh->refit(time);
+    if (this->bvh->sah_cost() > this->acceleration_info.rebuild_cost_ratio * this->built_sah_cost)
+    {
+        this->rebuild_acceleration();
+        return true;
+    }
+    return false;
+}
+
+bool scene::is_acceleration_built() const
+{
+    return this->bvh != nullptr;
+}
+
+float scene::acceleration_sah_cost() const
+{
+    return this->bvh ? this->bvh->sah_cost() : 0.f;
+}
+
+intersection_opt scene::intersect(const line& ray, const min_max<float> t) const
+{
+    if (this->bvh)
+    {
+        return this->bvh->intersect(ray, t);
+    }
+
+    // Without a hierarchy every shape is tested, and the primitive of a hit is its shape's index.
+    intersection_opt closest;
+    min_max<float> interval = t;
+    for (uint32_t s = 0; s < this->shapes.size(); ++s)
+    {
+        if (const intersection_opt i = this->intersect_shape(this->shapes[s], ray, interval))
+        {
+            interval.max = i->t;
+            closest = intersection{ i->t, s };
+        }
+    }
+    return closest;
+}
+
+hit_record scene::finalize(const line& ray, const intersection& i) const
+{
+    if (this->bvh)
+    {
+        return this->bvh->finalize(ray, i);
+    }
+
+    const shape& s = this->shapes[i.primitive];
+    switch (s.type)
+    {
+    case shape_type::ball:
+        return this->balls[s.index].finalize(ray, intersection{ i.t });
+    case shape_type::none:
+        break;
+    }
+    throw std::runtime_error{ "scene: Unknown shape type." };
+}
+
+bool scene::occluded(const line& ray, const min_max<float> t) const
+{
+    if (this->bvh)
+    {
+        return this->bvh->occluded(ray, t);
+    }
+
+    for (const shape& s : this->shapes)
+    {
+        switch (s.type)
+        {
+        case shape_type::ball:
+            if (this->balls[s.index].occluded(ray, t))
+            {
+                return true;
+            }
+            break;
+        case shape_type::none:
+            break;
+        }
+    }
+    return false;
+}
+
+void scene::hit(const line_packet& packet, const min_max<float> t, std::array<hit_record_opt, line_packet::size>& hits) const
+{
+    if (this->bvh)
+    {
+        this->bvh->hit(packet, t, hits);
+        return;
+    }
+
+    for (uint32_t lane = 0; lane < packet.count(); ++lane)
+    {
+        hits[lane] = hittable::hit(packet[lane], t);
+    }
+}
+
+material scene::add_material(dielectric&& in_material)
+{
+    this->dielectric_materials.push_back(std::move(in_material));
+    return material{ material_type::dielectric, array_index(this->dielectric_materials.size() - 1) };
+}
+
+material scene::add_material(diffuse_light&& in_material)
+{
+    this->diffuse_light_materials.push_back(std::move(in_material));
+    return material{ material_type::diffuse_light, array_index(this->diffuse_light_materials.size() - 1) };
+}
+
+material scene::add_material(lambertian&& in_material)
+{
+    this->lambertian_materials.push_back(std::move(in_material));
+    return material{ material_type::lambertian, array_index(this->lambertian_materials.size() - 1) };
+}
+
+material scene::add_material(metal&& in_material)
+{
+    this->metal_materials.push_back(std::move(in_material));
+    return material{ material_type::metal, array_index(this->metal_materials.size() - 1) };
+}
+
+texture scene::add_texture(checker_texture&& in_texture)
+{
+    this->checker_textures.push_back(std::move(in_texture));
+    return texture{ texture_type::checker, array_index(this->checker_textures.size() - 1) };
+}
+
+texture scene::add_texture(constant_texture&& in_texture)
+{
+    this->constant_textures.push_back(std::move(in_texture));
+    return texture{ texture_type::constant, array_index(this->constant_textures.size() - 1) };
+}
+
+texture scene::add_texture(image_texture&& in_texture)
+{
+    this->image_textures.push_back(std::move(in_texture));
+    return texture{ texture_type::image, array_index(this->image_textures.size() - 1) };
+}
+
+texture scene::add_texture(noise_texture&& in_texture)
+{
+    in_texture.noise_index = array_index(this->perlin_noises.size());
+    this->perlin_noises.emplace_back();
+    this->noise_textures.push_back(std::move(in_texture));
+    return texture{ texture_type::noise, array_index(this->noise_textures.size() - 1) };
+}
+
+image_texture scene::add_image(image&& in_image)
+{
+    if (in_image.texels.size() != size_t(in_image.size.width) * in_image.size.height)
+    {
+        throw std::runtime_error{ "scene: Image size don't match the data size." };
+    }
+
+    const extent_2d<uint32_t> size = in_image.size;
+    // Copied into the scene's memory resource, unless they were allocated from it already.
+    this->images.push_back(image{ std::pmr::vector<color>(std::move(in_image.texels), this->pool.get()), size });
+    return image_texture(array_index(this->images.size() - 1), size);
+}
+
+color scene::value_at(texture tex, const std::pair<float, float> uv, const position& p) const
+{
+    while (tex.type == texture_type::checker)
+    {
+        tex = this->checker_textures[tex.index].select(p);
+    }
+
+    switch (tex.type)
+    {
+    case texture_type::constant:
+        return this->constant_textures[tex.index].value_at();
+    case texture_type::image:
+    {
+        const image_texture& t = this->image_textures[tex.index];
+        return t.value_at(this->images[t.image_index], uv);
+    }
+    case texture_type::noise:
+    {
+        const noise_texture& t = this->noise_textures[tex.index];
+        return t.value_at(this->perlin_noises[t.noise_index], p);
+    }
+    case texture_type::none:
+    case texture_type::checker:
+        break;
+    }
+    throw std::runtime_error{ "scene: Unknown texture type." };
+}
+
+scattering_opt scene::scatter(const line& ray, const hit_record& hit, sample_stream& samples) const
+{
+    switch (hit.material.type)
+    {
+    case material_type::dielectric:
+    {
+        const dielectric& m = this->dielectric_materials[hit.material.index];
+        return m.scatter(ray, hit, this->value_at(m.albedo, hit.uv, hit.point), samples);
+    }
+    case material_type::lambertian:
+    {
+        const lambertian& m = this->lambertian_materials[hit.material.index];
+        return m.scatter(ray, hit, this->value_at(m.albedo, hit.uv, hit.point), samples);
+    }
+    case material_type::metal:
+    {
+        const metal& m = this->metal_materials[hit.material.index];
+        return m.scatter(ray, hit, this->value_at(m.albedo, hit.uv, hit.point), samples);
+    }
+    case material_type::none:
+    case material_type::diffuse_light:
+        return {};
+    }
+    throw std::runtime_error{ "scene: Unknown material type." };
+}
+
+color scene::emitted(const hit_record& hit) const
+{
+    if (hit.material.type == material_type::diffuse_light)
+    {
+        return this->value_at(this->diffuse_light_materials[hit.material.index].emit, hit.uv, hit.point);
+    }
+    return color{ 0.f };
+}
+
+// The types are laid out as in the std140 scene block of the shaders. Their sizes are multiples of
+// 16 bytes there, so the arrays can be copied one after another.
+static_assert(sizeof(texture) == 16);
+static_assert(sizeof(shape) == 16);
+static_assert(sizeof(ball) == 64);
+static_assert(sizeof(dielectric) == 32);
+static_assert(sizeof(diffuse_light) == 16);
+static_assert(sizeof(lambertian) == 16);
+static_assert(sizeof(metal) == 32);
+static_assert(sizeof(checker_texture) == 48);
+static_assert(sizeof(constant_texture) == 16);
+static_assert(sizeof(image_texture) == 32);
+static_assert(sizeof(noise_texture) == 32);
+
+std::vector<uint8_t> scene::to_bytes() const
+{
+    std::vector<uint8_t> bytes(this->size(), 0);
+    size_t current_position = 0;
+    const auto append_data = [&](const auto* source, const size_t count)
+    {
+        using element = std::remove_pointer_t<decltype(source)>;
+        static_assert(std::is_trivially_copyable_v<element>);
+
+        std::memcpy(bytes.data() + current_position, source, sizeof(element) * count);
+        current_position += sizeof(element) * count;
+    };
+    append_data(&this->sky, 1);
+    append_data(this->shapes.data(), this->shapes.size());
+    append_data(this->balls.data(), this->balls.size());
+    append_data(this->dielectric_materials.data(), this->dielectric_materials.size());
+    append_data(this->diffuse_light_materials.data(), this->diffuse_light_materials.size());
+    append_data(this->lambertian_materials.data(), this->lambertian_materials.size());
+    append_data(this->metal_materials.data(), this->metal_materials.size());
+    append_data(this->checker_textures.data(), this->checker_textures.size());
+    append_data(this->constant_textures.data(), this->constant_textures.size());
+    append_data(this->image_textures.data(), this->image_textures.size());
+    append_data(this->noise_textures.data(), this->noise_textures.size());
+    return bytes;
+}
+
+size_t scene::size() const
+{
+    return sizeof(texture)
+        + sizeof(shape) * this->shapes.size()
+        + sizeof(ball) * this->balls.size()
+        + sizeof(dielectric) * this->dielectric_materials.size()
+        + sizeof(diffuse_light) * this->diffuse_light_materials.size()
+        + sizeof(lambertian) * this->lambertian_materials.size()
+        + sizeof(metal) * this->metal_materials.size()
+        + sizeof(checker_texture) * this->checker_textures.size()
+        + sizeof(constant_texture) * this->constant_textures.size()
+        + sizeof(image_texture) * this->image_textures.size()
+        + sizeof(noise_texture) * this->noise_textures.size();
 }
 
 axis_aligned_bounding_box_opt scene::bounding_box(const min_max<float> t) const
 {
-    return this->box;
+    if (!this->bvh)
+    {
+        return {};
+    }
+    return this->bvh->bounding_box(t);
+}
+
+intersection_opt scene::intersect_shape(const shape& s, const line& ray, const min_max<float> t) const
+{
+    switch (s.type)
+    {
+    case shape_type::ball:
+        return this->balls[s.index].intersect(ray, t);
+    case shape_type::none:
+        return {};
+    }
+    throw std::runtime_error{ "scene: Unknown shape type." };
+}
+
+void scene::rebuild_acceleration()
+{
+    this->bvh = std::make_unique<linear_bounding_volume_hierarchy>(this->shapes, this->balls, this->acceleration_time, this->acceleration_info);
+    this->built_sah_cost = this->bvh->sah_cost();
 }
\ No newline at end of file
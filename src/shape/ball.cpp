@@ -3,18 +3,19 @@
 #include <line.hpp>
 #include <math/sphere.hpp>
 
-ball::ball(const position& center, const float radius, unique_material&& mat)
-    : ball({ center, center }, { 0.f, 0.f }, radius, std::move(mat))
+ball::ball(const position& center, const float radius, const material& mat)
+    : ball({ center, center }, { 0.f, 0.f }, radius, mat)
 {
 }
 
 ball::ball(const from_to<position>& center_transition, const min_max<float> time_transition,
-    const float radius, unique_material&& mat)
-    : center_transition(center_transition)
-    , time_transition(time_transition)
+    const float radius, const material& mat)
+    : center_from(center_transition.from)
     , radius(radius)
+    , center_to(center_transition.to)
     , inverse_radius(1.f / radius)
-    , mat(std::move(mat))
+    , time_transition(time_transition)
+    , mat(mat)
 {
     if (const float interval = time_transition.max - time_transition.min; interval != 0.f)
     {
@@ -22,50 +23,61 @@ ball::ball(const from_to<position>& center_transition, const min_max<float> time
     }
 }
 
-hit_record_opt ball::hit(const line& ray, const min_max<float> t) const
+intersection_opt ball::intersect(const line& ray, const min_max<float> t) const
 {
     const displacement oc = ray.origin - this->center_at_time(ray.time);
     const float a = glm::dot(ray.direction, ray.direction);
     const float b = glm::dot(oc, ray.direction);
-    const float c = glm::dot(oc, oc) - glm::pow(this->radius, 2);
+    const float c = glm::dot(oc, oc) - this->radius * this->radius;
     const float discriminant = b * b - a * c;
 
     if (discriminant > 0.f)
     {
-        if (const float root_1 = (-b - glm::sqrt(discriminant)) / a; root_1 < t.max && root_1 > t.min)
+        const float root = glm::sqrt(discriminant);
+        if (const float root_1 = (-b - root) / a; root_1 < t.max && root_1 > t.min)
         {
-            const position point = ray.point_at_parameter(root_1);
-            const std::pair<float, float> uv = this->uv_at(point, ray.time);
-            return hit_record{ root_1, point, (point - this->center_at_time(ray.time)) / this->radius, this->mat.get(), uv };
+            return intersection{ root_1 };
         }
-        if (const float root_2 = (-b + glm::sqrt(discriminant)) / a; root_2 < t.max && root_2 > t.min)
+        if (const float root_2 = (-b + root) / a; root_2 < t.max && root_2 > t.min)
         {
-            const position point = ray.point_at_parameter(root_2);
-            const std::pair<float, float> uv = this->uv_at(point, ray.time);
-            return hit_record{ root_2, point, (point - this->center_at_time(ray.time)) / this->radius, this->mat.get(), uv };
+            return intersection{ root_2 };
         }
     }
     return {};
 }
 
+hit_record ball::finalize(const line& ray, const intersection& i) const
+{
+    const position center = this->center_at_time(ray.time);
+    const position point = ray.point_at_parameter(i.t);
+    const std::pair<float, float> uv = uv_on_sphere(glm::abs(this->inverse_radius) * (point - center));
+    return hit_record{ i.t, point, (point - center) / this->radius, this->mat, uv };
+}
+
+bool ball::occluded(const line& ray, const min_max<float> t) const
+{
+    // Finding the nearer of the two roots costs nothing extra for a single ball.
+    return this->intersect(ray, t).has_value();
+}
+
 axis_aligned_bounding_box_opt ball::bounding_box(const min_max<float> t) const
 {
+    // The center moves along a segment, so its positions at both ends of the interval bound it.
     const float r = glm::abs(this->radius);
+    const position from = this->center_at_time(t.min);
+    const position to = this->center_at_time(t.max);
     return axis_aligned_bounding_box::surrounding(
-        axis_aligned_bounding_box{
-            position{ this->center_transition.from - displacement{ r } },
-            position{ this->center_transition.from + displacement{ r } } },
-        axis_aligned_bounding_box{
-            position{ this->center_transition.to - displacement{ r } },
-            position{ this->center_transition.to + displacement{ r } } });
+        axis_aligned_bounding_box{ position{ from - displacement{ r } }, position{ from + displacement{ r } } },
+        axis_aligned_bounding_box{ position{ to - displacement{ r } }, position{ to + displacement{ r } } });
 }
 
 position ball::center_at_time(const float time) const
 {
-    const position from = this->center_transition.from;
-    const position to = this->center_transition.to;
+    const position from = this->center_from;
+    const position to = this->center_to;
     const float t_min = this->time_transition.min;
-    return from + ((time - t_min) * this->inverse_time_interval) * (to - from);
+    // Outside of its motion interval the ball rests at either end.
+    return from + glm::clamp((time - t_min) * this->inverse_time_interval, 0.f, 1.f) * (to - from);
 }
 
 std::pair<float, float> ball::uv_at(const position& p, const float time) const
@@ -0,0 +1,134 @@
+#include <shape/ball_batch.hpp>
+
+#include <line.hpp>
+#include <shape/ball.hpp>
+#include <util/simd.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+ball_batch::ball_batch()
+    : center_x(lane_count, 0.f)
+    , center_y(lane_count, 0.f)
+    , center_z(lane_count, 0.f)
+    , motion_x(lane_count, 0.f)
+    , motion_y(lane_count, 0.f)
+    , motion_z(lane_count, 0.f)
+    , start_time(lane_count, 0.f)
+    , inverse_duration(lane_count, 0.f)
+    // A NaN radius makes every comparison of the intersection test fail.
+    , radius(lane_count, std::numeric_limits<float>::quiet_NaN())
+{
+}
+
+void ball_batch::push_back(const ball* b)
+{
+    // The new ball takes the place of the first placeholder, and a new one is appended.
+    if (b)
+    {
+        this->store(this->balls.size(), *b);
+    }
+
+    for (std::vector<float>* values : { &this->center_x, &this->center_y, &this->center_z, &this->motion_x,
+        &this->motion_y, &this->motion_z, &this->start_time, &this->inverse_duration })
+    {
+        values->push_back(0.f);
+    }
+    this->radius.push_back(std::numeric_limits<float>::quiet_NaN());
+    this->balls.push_back(b);
+}
+
+bool ball_batch::is_ball(const uint32_t index) const
+{
+    return this->balls[index] != nullptr;
+}
+
+void ball_batch::refresh()
+{
+    for (size_t i = 0; i < this->balls.size(); ++i)
+    {
+        if (this->balls[i])
+        {
+            this->store(i, *this->balls[i]);
+        }
+    }
+}
+
+void ball_batch::store(const size_t i, const ball& b)
+{
+    const displacement motion = b.center_to - b.center_from;
+    this->center_x[i] = b.center_from.x;
+    this->center_y[i] = b.center_from.y;
+    this->center_z[i] = b.center_from.z;
+    this->motion_x[i] = motion.x;
+    this->motion_y[i] = motion.y;
+    this->motion_z[i] = motion.z;
+    this->start_time[i] = b.time_transition.min;
+    this->inverse_duration[i] = b.inverse_time_interval;
+    this->radius[i] = b.radius;
+}
+
+intersection_opt ball_batch::closest_hit(const line& ray, const uint32_t first, const uint32_t count,
+    const min_max<float> t) const
+{
+    intersection_opt closest;
+    float closest_t = t.max;
+    std::array<float, lane_count> roots;
+    for (uint32_t i = first; i < first + count; i += lane_count)
+    {
+        const uint32_t in_range = (1u << std::min(lane_count, first + count - i)) - 1u;
+        const uint32_t lanes = this->hit_lanes(ray, i, min_max<float>{ t.min, closest_t }, roots) & in_range;
+        for (uint32_t lane = 0; lane < lane_count; ++lane)
+        {
+            if ((lanes & (1u << lane)) && roots[lane] < closest_t)
+            {
+                closest_t = roots[lane];
+                closest = intersection{ roots[lane], i + lane };
+            }
+        }
+    }
+    return closest;
+}
+
+bool ball_batch::occluded(const line& ray, const uint32_t first, const uint32_t count, const min_max<float> t) const
+{
+    std::array<float, lane_count> roots;
+    for (uint32_t i = first; i < first + count; i += lane_count)
+    {
+        const uint32_t in_range = (1u << std::min(lane_count, first + count - i)) - 1u;
+        if (this->hit_lanes(ray, i, t, roots) & in_range)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t ball_batch::hit_lanes(const line& ray, const uint32_t i, const min_max<float> t,
+    std::array<float, lane_count>& roots) const
+{
+    // Same arithmetic as ball::intersect, so both find the same distances.
+    const float8 zero{ 0.f };
+    const float8 a{ glm::dot(ray.direction, ray.direction) };
+    const float8 s = min(max(float8{ 0.f },
+        (float8{ ray.time } - float8::load_unaligned(&this->start_time[i])) * float8::load_unaligned(&this->inverse_duration[i])), float8{ 1.f });
+    const float8 oc_x = float8{ ray.origin.x } - (float8::load_unaligned(&this->center_x[i]) + s * float8::load_unaligned(&this->motion_x[i]));
+    const float8 oc_y = float8{ ray.origin.y } - (float8::load_unaligned(&this->center_y[i]) + s * float8::load_unaligned(&this->motion_y[i]));
+    const float8 oc_z = float8{ ray.origin.z } - (float8::load_unaligned(&this->center_z[i]) + s * float8::load_unaligned(&this->motion_z[i]));
+    const float8 r = float8::load_unaligned(&this->radius[i]);
+
+    const float8 b = oc_x * float8{ ray.direction.x } + oc_y * float8{ ray.direction.y } + oc_z * float8{ ray.direction.z };
+    const float8 c = (oc_x * oc_x + oc_y * oc_y + oc_z * oc_z) - r * r;
+    const float8 discriminant = b * b - a * c;
+    const float8 root = sqrt(discriminant);
+    const float8 root_1 = (zero - b - root) / a;
+    const float8 root_2 = (zero - b + root) / a;
+
+    const float8 t_min{ t.min };
+    const float8 t_max{ t.max };
+    const mask8 valid_1 = (root_1 < t_max) & (t_min < root_1);
+    const mask8 valid_2 = (root_2 < t_max) & (t_min < root_2);
+    select(valid_1, root_1, root_2).store_unaligned(roots.data());
+    return bits((zero < discriminant) & (valid_1 | valid_2));
+}
\ No newline at end of file
@@ -4,28 +4,20 @@
 #include <stb_image.h>
 
 #include <algorithm>
-#include <stdexcept>
 
-image_texture::image_texture(const std::vector<color>& data, const extent_2d<size_t> size)
-    : data(data), size(size)
-{
-    if (this->data.size() != size.width * size.height)
-    {
-        throw std::runtime_error("Image size don't match the data size.");
-    }
-}
-
-image_texture::image_texture(std::string_view image_path)
+image load_image(std::string_view image_path)
 {
     int width, height, channels;
     uint8_t* data = stbi_load(image_path.data(), &width, &height, &channels, STBI_rgb_alpha);
-    this->size = extent_2d<size_t>{ size_t(width), size_t(height) };
+
+    image result;
+    result.size = extent_2d<uint32_t>{ uint32_t(width), uint32_t(height) };
 
     const float normalized_rgb = 1.f / 255.f;
-    this->data.resize(size_t(width) * height);
+    result.texels.resize(size_t(width) * height);
     for (size_t i = 0; i < size_t(width) * height; ++i)
     {
-        this->data[i] = normalized_rgb * color{
+        result.texels[i] = normalized_rgb * color{
             data[4 * i + 0],
             data[4 * i + 1],
             data[4 * i + 2],
@@ -33,12 +25,18 @@ image_texture::image_texture(std::string_view image_path)
     }
 
     stbi_image_free(data);
+    return result;
+}
+
+image_texture::image_texture(const array_index image_index, const extent_2d<uint32_t> size)
+    : image_index(image_index), size(size)
+{
 }
 
-color image_texture::value_at(const std::pair<float, float> uv, const position&) const
+color image_texture::value_at(const image& img, const std::pair<float, float> uv) const
 {
     const auto [u, v] = uv;
-    const size_t i = std::clamp<size_t>(u * float(this->size.width), 0, this->size.width - 1);
-    const size_t j = std::clamp<size_t>((1.f - v) * float(this->size.height) - 0.001f, 0, this->size.height - 1);
-    return this->data[i + j * this->size.width];
+    const size_t i = std::clamp<size_t>(u * float(img.size.width), 0, img.size.width - 1);
+    const size_t j = std::clamp<size_t>((1.f - v) * float(img.size.height) - 0.001f, 0, img.size.height - 1);
+    return img.texels[i + j * img.size.width];
 }
\ No newline at end of file
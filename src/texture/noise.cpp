@@ -1,13 +1,25 @@
 #include <texture/noise.hpp>
 
-noise_texture::noise_texture(const float scale, const color& albedo, const noise_transform_fn& noise_transform)
+noise_texture::noise_texture(const float scale, const color& albedo, const noise_transform transform)
     : scale(scale)
     , albedo(albedo)
-    , noise_transform(noise_transform)
+    , transform(transform)
 {
 }
 
-color noise_texture::value_at(const std::pair<float, float> uv, const position& p) const
+color noise_texture::value_at(const perlin& noise, const position& p) const
 {
-    return this->albedo * this->noise_transform(this->noise, this->scale * p);
+    const glm::vec3 q = this->scale * p;
+    switch (this->transform)
+    {
+    case noise_transform::smooth:
+        return this->albedo * (0.5f * (1.f + noise.noise(q)));
+    case noise_transform::turbulence:
+        return this->albedo * turbulence(noise, q);
+    case noise_transform::soft_turbulence:
+        return this->albedo * (0.5f * (1.f + turbulence(noise, q)));
+    case noise_transform::marble:
+        return this->albedo * (0.5f * (1.f + glm::sin(q.z + 10.f * turbulence(noise, q))));
+    }
+    return color{ 0.f };
 }
\ No newline at end of file
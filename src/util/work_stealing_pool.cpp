@@ -0,0 +1,323 @@
+#include <util/work_stealing_pool.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__linux__)
+#   include <pthread.h>
+#   include <sched.h>
+
+#   include <filesystem>
+#   include <fstream>
+#   include <sstream>
+#   include <string>
+#elif defined(_WIN32)
+#   define NOMINMAX
+#   include <windows.h>
+#endif
+
+work_stealing_pool::work_stealing_pool(const uint32_t thread_count, const thread_affinity affinity)
+{
+    if (thread_count == 0)
+    {
+        throw std::runtime_error{ "work_stealing_pool: Thread count should be greater than zero." };
+    }
+
+    this->queues.reserve(thread_count);
+    for (uint32_t i = 0; i < thread_count; ++i)
+    {
+        this->queues.push_back(std::make_unique<job_queue>());
+    }
+
+    const std::vector<uint32_t> placement = cpu_placement(affinity);
+
+    this->workers.reserve(thread_count);
+    for (uint32_t i = 0; i < thread_count; ++i)
+    {
+        this->workers.emplace_back(&work_stealing_pool::work, this, i);
+        if (!placement.empty())
+        {
+            pin_to_cpu(this->workers.back(), placement[i % placement.size()]);
+        }
+    }
+}
+
+work_stealing_pool::~work_stealing_pool()
+{
+    {
+        std::lock_guard lock{ this->state_mtx };
+        this->stopping = true;
+    }
+    this->work_available.notify_all();
+
+    for (std::thread& worker : this->workers)
+    {
+        worker.join();
+    }
+}
+
+void work_stealing_pool::run(std::vector<job>&& jobs)
+{
+    if (jobs.empty())
+    {
+        return;
+    }
+
+    std::unique_lock lock{ this->state_mtx };
+    this->pending_jobs = jobs.size();
+    this->first_error = nullptr;
+
+    const size_t chunk_size = (jobs.size() + this->queues.size() - 1) / this->queues.size();
+    for (size_t i = 0; i < this->queues.size(); ++i)
+    {
+        const size_t chunk_begin = std::min(i * chunk_size, jobs.size());
+        const size_t chunk_end = std::min(chunk_begin + chunk_size, jobs.size());
+
+        std::lock_guard queue_lock{ this->queues[i]->mtx };
+        std::move(jobs.begin() + chunk_begin, jobs.begin() + chunk_end, std::back_inserter(this->queues[i]->jobs));
+    }
+
+    ++this->batch;
+    this->work_available.notify_all();
+    this->work_finished.wait(lock, [this] { return this->pending_jobs == 0; });
+
+    if (this->first_error)
+    {
+        std::rethrow_exception(std::exchange(this->first_error, nullptr));
+    }
+}
+
+uint32_t work_stealing_pool::size() const
+{
+    return uint32_t(this->workers.size());
+}
+
+void work_stealing_pool::work(const uint32_t worker_index)
+{
+    uint64_t seen_batch = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock{ this->state_mtx };
+            this->work_available.wait(lock, [&] { return this->stopping || this->batch != seen_batch; });
+            if (this->stopping)
+            {
+                return;
+            }
+            seen_batch = this->batch;
+        }
+
+        while (std::optional<job> next = this->take_job(worker_index))
+        {
+            std::exception_ptr error;
+            try
+            {
+                (*next)();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            std::lock_guard lock{ this->state_mtx };
+            if (error && !this->first_error)
+            {
+                this->first_error = error;
+            }
+            if (--this->pending_jobs == 0)
+            {
+                this->work_finished.notify_all();
+            }
+        }
+    }
+}
+
+std::optional<work_stealing_pool::job> work_stealing_pool::take_job(const uint32_t worker_index)
+{
+    {
+        job_queue& own = *this->queues[worker_index];
+        std::lock_guard lock{ own.mtx };
+        if (!own.jobs.empty())
+        {
+            job next = std::move(own.jobs.front());
+            own.jobs.pop_front();
+            return next;
+        }
+    }
+
+    for (size_t offset = 1; offset < this->queues.size(); ++offset)
+    {
+        job_queue& victim = *this->queues[(worker_index + offset) % this->queues.size()];
+        std::lock_guard lock{ victim.mtx };
+        if (!victim.jobs.empty())
+        {
+            job next = std::move(victim.jobs.back());
+            victim.jobs.pop_back();
+            return next;
+        }
+    }
+    return {};
+}
+
+#if defined(__linux__)
+// Returns nothing if the list is malformed.
+static std::optional<std::vector<uint32_t>> parse_cpu_list(const std::string& list)
+{
+    std::vector<uint32_t> cpus;
+    std::stringstream ranges{ list };
+    for (std::string range; std::getline(ranges, range, ',');)
+    {
+        if (range.empty())
+        {
+            continue;
+        }
+        const size_t dash = range.find('-');
+        unsigned long first = 0;
+        unsigned long last = 0;
+        try
+        {
+            first = std::stoul(range.substr(0, dash));
+            last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+        }
+        catch (const std::logic_error&)
+        {
+            return {};
+        }
+        if (last >= CPU_SETSIZE || first > last)
+        {
+            return {};
+        }
+        for (unsigned long cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(uint32_t(cpu));
+        }
+    }
+    return cpus;
+}
+#endif
+
+std::vector<uint32_t> work_stealing_pool::cpu_placement(const thread_affinity affinity)
+{
+    if (affinity == thread_affinity::none)
+    {
+        return {};
+    }
+
+#if defined(__linux__)
+    cpu_set_t available_set;
+    CPU_ZERO(&available_set);
+    if (sched_getaffinity(0, sizeof(available_set), &available_set) != 0)
+    {
+        return {};
+    }
+
+    std::vector<uint32_t> available;
+    for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+        if (CPU_ISSET(cpu, &available_set))
+        {
+            available.push_back(cpu);
+        }
+    }
+
+    if (affinity == thread_affinity::pinned)
+    {
+        return available;
+    }
+
+    std::vector<std::vector<uint32_t>> nodes;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator{ "/sys/devices/system/node", error })
+    {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4
+            || !std::all_of(name.begin() + 4, name.end(), [](const char c) { return std::isdigit(c); }))
+        {
+            continue;
+        }
+
+        std::ifstream cpu_list_file{ entry.path() / "cpulist" };
+        std::string cpu_list;
+        std::getline(cpu_list_file, cpu_list);
+
+        const std::optional<std::vector<uint32_t>> listed_cpus = parse_cpu_list(cpu_list);
+        if (!listed_cpus)
+        {
+            // Without a reliable topology, threads are pinned round-robin.
+            return available;
+        }
+
+        std::vector<uint32_t> node_cpus;
+        for (const uint32_t cpu : *listed_cpus)
+        {
+            if (CPU_ISSET(cpu, &available_set))
+            {
+                node_cpus.push_back(cpu);
+            }
+        }
+        if (!node_cpus.empty())
+        {
+            nodes.push_back(std::move(node_cpus));
+        }
+    }
+
+    if (nodes.size() < 2)
+    {
+        return available;
+    }
+
+    size_t largest_node_size = 0;
+    for (const std::vector<uint32_t>& node_cpus : nodes)
+    {
+        largest_node_size = std::max(largest_node_size, node_cpus.size());
+    }
+
+    std::vector<uint32_t> interleaved;
+    cpu_set_t interleaved_set;
+    CPU_ZERO(&interleaved_set);
+    for (size_t i = 0; i < largest_node_size; ++i)
+    {
+        for (const std::vector<uint32_t>& node_cpus : nodes)
+        {
+            if (i < node_cpus.size() && !CPU_ISSET(node_cpus[i], &interleaved_set))
+            {
+                interleaved.push_back(node_cpus[i]);
+                CPU_SET(node_cpus[i], &interleaved_set);
+            }
+        }
+    }
+
+    // CPUs the nodes do not list still get threads, after the interleaved ones.
+    for (const uint32_t cpu : available)
+    {
+        if (!CPU_ISSET(cpu, &interleaved_set))
+        {
+            interleaved.push_back(cpu);
+        }
+    }
+    return interleaved;
+#elif defined(_WIN32)
+    // NUMA topology is not queried on Windows, interleaving falls back to plain pinning.
+    std::vector<uint32_t> available(std::min(std::thread::hardware_concurrency(), 64u));
+    std::iota(available.begin(), available.end(), 0);
+    return available;
+#else
+    return {};
+#endif
+}
+
+void work_stealing_pool::pin_to_cpu(std::thread& worker, const uint32_t cpu)
+{
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    pthread_setaffinity_np(worker.native_handle(), sizeof(cpu_set), &cpu_set);
+#elif defined(_WIN32)
+    SetThreadAffinityMask(HANDLE(worker.native_handle()), DWORD_PTR(1) << cpu);
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "random_scene.hpp"
+
+#include <scene.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// An occlusion query has to agree with whether a closest hit is found, also on intervals that end
+// in front of the objects, like those of shadow rays towards a light.
+int main()
+{
+    scene world;
+    add_random_balls(world, 2000, 4);
+    const std::vector<line> rays = random_rays(8000, 5);
+
+    seed_random(6);
+    std::vector<min_max<float>> intervals;
+    for (size_t r = 0; r < rays.size(); ++r)
+    {
+        intervals.push_back(r % 2 == 0 ? line::hit_interval : min_max<float>{ line::hit_interval.min, random_uniform(0.f, 30.f) });
+    }
+
+    uint32_t failures = 0;
+    // Once testing every ball, once through the hierarchy.
+    for (const bool accelerated : { false, true })
+    {
+        if (accelerated)
+        {
+            world.build_acceleration(min_max<float>{ 0.f, 1.f });
+        }
+
+        for (size_t r = 0; r < rays.size(); ++r)
+        {
+            if (world.occluded(rays[r], intervals[r]) != world.intersect(rays[r], intervals[r]).has_value())
+            {
+                std::cerr << "Occlusion and closest hit disagree for ray " << r
+                    << (accelerated ? " through the hierarchy." : " without a hierarchy.") << std::endl;
+                ++failures;
+            }
+        }
+    }
+
+    if (failures != 0)
+    {
+        std::cerr << failures << " occlusion checks failed." << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <line.hpp>
+#include <material/lambertian.hpp>
+#include <scene.hpp>
+#include <shape/ball.hpp>
+#include <util/random.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// Balls of every kind the traversals have to handle: still, moving during part of the shutter
+// interval, and hollow ones with a negative radius. Every ball gets a material of its own, so
+// that the material of a hit tells which ball it is.
+inline static void add_random_balls(scene& world, const uint32_t count, const uint64_t seed)
+{
+    seed_random(seed);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const material mat = world.add_material(lambertian(world.sky));
+        const position center = { random_uniform(-20.f, 20.f), random_uniform(-20.f, 20.f), random_uniform(-20.f, 20.f) };
+        const float radius = random_uniform(0.1f, 1.5f);
+        if (random_chance(0.2f))
+        {
+            world.add_shape(ball(from_to<position>{ center, center + 2.f * random_direction() }, min_max<float>{ 0.25f, 0.75f },
+                radius, mat));
+        }
+        else
+        {
+            world.add_shape(ball(center, random_chance(0.05f) ? -radius : radius, mat));
+        }
+    }
+}
+
+// Random rays through the scene, some of them parallel to the axes, so that slab tests meet
+// directions with zero components.
+inline static std::vector<line> random_rays(const uint32_t count, const uint64_t seed)
+{
+    seed_random(seed);
+    std::vector<line> rays;
+    rays.reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const position origin = { random_uniform(-25.f, 25.f), random_uniform(-25.f, 25.f), random_uniform(-25.f, 25.f) };
+        displacement direction = random_direction();
+        if (i % 8 == 0)
+        {
+            direction = displacement{ 0.f };
+            direction[i / 8 % 3] = random_chance() ? 1.f : -1.f;
+        }
+        rays.push_back(line{ origin, direction, random_uniform(0.f, 1.f) });
+    }
+    return rays;
+}
\ No newline at end of file
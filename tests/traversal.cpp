@@ -0,0 +1,224 @@
+#include "random_scene.hpp"
+
+#include <line_packet.hpp>
+#include <scene.hpp>
+#include <shape/ball_batch.hpp>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+// Every traversal has to find the hit a test of every ball finds: single rays through the 4-wide
+// hierarchy, coherent and incoherent packets, and the batched test of the balls in a leaf.
+
+static uint32_t failures = 0;
+
+static void check(const bool passed, const std::string_view what, const size_t ray)
+{
+    if (!passed)
+    {
+        std::cerr << what << " differs from the brute-force scan for ray " << ray << "." << std::endl;
+        ++failures;
+    }
+}
+
+// Batched and scalar intersections compute the roots in a different order, so distances may differ
+// in the last bits.
+static bool same_hit(const hit_record_opt& a, const hit_record_opt& b)
+{
+    if (!a || !b)
+    {
+        return a.has_value() == b.has_value();
+    }
+    return glm::abs(a->t - b->t) <= 1e-4f * std::max(1.f, a->t) && a->material.index == b->material.index;
+}
+
+static hit_record_opt brute_force_hit(const scene& world, const line& ray)
+{
+    const ball* closest = nullptr;
+    intersection_opt closest_intersection;
+    min_max<float> t = line::hit_interval;
+    for (const ball& b : world.balls)
+    {
+        if (const intersection_opt i = b.intersect(ray, t))
+        {
+            t.max = i->t;
+            closest = &b;
+            closest_intersection = i;
+        }
+    }
+    return closest ? closest->finalize(ray, *closest_intersection) : hit_record_opt{};
+}
+
+// Camera-like bundles of eight rays from one origin, followed by bundles of unrelated rays.
+static std::vector<line_packet> make_packets(const std::vector<line>& rays)
+{
+    std::vector<line_packet> packets;
+    seed_random(3);
+    for (size_t p = 0; p < 256; ++p)
+    {
+        line_packet packet;
+        const position origin = { random_uniform(-25.f, 25.f), random_uniform(-25.f, 25.f), random_uniform(-25.f, 25.f) };
+        const displacement toward = position{ 0.f } - origin;
+        const float time = random_uniform(0.f, 1.f);
+        for (uint32_t i = 0; i < line_packet::size; ++i)
+        {
+            packet.add(line{ origin, toward + 2.f * random_direction(), time });
+        }
+        packets.push_back(packet);
+    }
+    for (size_t first = 0; first < rays.size(); first += line_packet::size)
+    {
+        line_packet packet;
+        // The last packet is only partly filled.
+        for (size_t i = first; i < std::min(first + line_packet::size, rays.size()); ++i)
+        {
+            packet.add(rays[i]);
+        }
+        packets.push_back(packet);
+    }
+    return packets;
+}
+
+static void check_batch(const scene& world, const std::vector<line>& rays)
+{
+    // Placeholders between the balls stand for primitives of other types, and the ranges tested
+    // start and end anywhere within a group of eight.
+    ball_batch batch;
+    std::vector<const ball*> primitives;
+    for (size_t i = 0; i < 40; ++i)
+    {
+        primitives.push_back(i % 7 == 3 ? nullptr : &world.balls[i]);
+        batch.push_back(primitives.back());
+    }
+
+    for (size_t r = 0; r < rays.size(); ++r)
+    {
+        const uint32_t first = uint32_t(r % 13);
+        const uint32_t count = uint32_t(r % 27);
+        intersection_opt expected;
+        min_max<float> t = line::hit_interval;
+        for (uint32_t p = first; p < first + count; ++p)
+        {
+            if (const intersection_opt i = primitives[p] ? primitives[p]->intersect(rays[r], t) : intersection_opt{})
+            {
+                t.max = i->t;
+                expected = intersection{ i->t, p };
+            }
+        }
+
+        const intersection_opt batched = batch.closest_hit(rays[r], first, count, line::hit_interval);
+        check(batched.has_value() == expected.has_value()
+            && (!batched || (batched->primitive == expected->primitive && glm::abs(batched->t - expected->t) <= 1e-4f * std::max(1.f, expected->t))),
+            "Batched closest hit", r);
+        check(batch.occluded(rays[r], first, count, line::hit_interval) == expected.has_value(), "Batched occlusion", r);
+    }
+}
+
+int main()
+{
+    scene world;
+    add_random_balls(world, 2000, 1);
+    const std::vector<line> rays = random_rays(8000, 2);
+    const std::vector<line_packet> packets = make_packets(rays);
+
+    std::vector<hit_record_opt> expected;
+    for (const line& ray : rays)
+    {
+        expected.push_back(brute_force_hit(world, ray));
+    }
+    std::vector<std::array<hit_record_opt, line_packet::size>> expected_packets;
+    for (const line_packet& packet : packets)
+    {
+        std::array<hit_record_opt, line_packet::size>& hits = expected_packets.emplace_back();
+        for (uint32_t i = 0; i < packet.count(); ++i)
+        {
+            hits[i] = brute_force_hit(world, packet[i]);
+        }
+    }
+
+    check_batch(world, rays);
+
+    bounding_volume_hierarchy_create_info single_ball_leaves;
+    single_ball_leaves.max_leaf_size = 1;
+    bounding_volume_hierarchy_create_info large_leaves;
+    large_leaves.max_leaf_size = 16;
+    large_leaves.bin_count = 4;
+    for (const bounding_volume_hierarchy_create_info& info : { bounding_volume_hierarchy_create_info{}, single_ball_leaves, large_leaves })
+    {
+        world.build_acceleration(min_max<float>{ 0.f, 1.f }, info);
+
+        for (size_t r = 0; r < rays.size(); ++r)
+        {
+            check(same_hit(world.hit(rays[r], line::hit_interval), expected[r]), "Closest hit", r);
+        }
+
+        for (size_t p = 0; p < packets.size(); ++p)
+        {
+            std::array<hit_record_opt, line_packet::size> hits;
+            world.hit(packets[p], line::hit_interval, hits);
+            for (uint32_t i = 0; i < line_packet::size; ++i)
+            {
+                check(same_hit(hits[i], expected_packets[p][i]), "Packet closest hit", p * line_packet::size + i);
+            }
+        }
+    }
+
+    // Balls moved in place are found where they are now once the hierarchy is refitted, also by
+    // the batched test of the leaves. The moved balls keep the materials of the balls they replace.
+    bounding_volume_hierarchy_create_info never_rebuilt;
+    never_rebuilt.rebuild_cost_ratio = FLT_MAX;
+    world.build_acceleration(min_max<float>{ 0.f, 1.f }, never_rebuilt);
+    scene moved;
+    add_random_balls(moved, uint32_t(world.balls.size()), 7);
+    std::copy(moved.balls.begin(), moved.balls.end(), world.balls.begin());
+    check(!world.update_acceleration(min_max<float>{ 0.f, 1.f }), "Refitting", 0);
+    for (size_t r = 0; r < rays.size(); ++r)
+    {
+        check(same_hit(world.hit(rays[r], line::hit_interval), brute_force_hit(moved, rays[r])), "Refitted closest hit", r);
+    }
+    for (size_t p = 0; p < packets.size(); ++p)
+    {
+        std::array<hit_record_opt, line_packet::size> hits;
+        world.hit(packets[p], line::hit_interval, hits);
+        for (uint32_t i = 0; i < packets[p].count(); ++i)
+        {
+            check(same_hit(hits[i], brute_force_hit(moved, packets[p][i])), "Refitted packet closest hit", p * line_packet::size + i);
+        }
+    }
+
+    // Scenes of more than parallel_build_threshold objects are split into subtrees that are built in
+    // parallel and spliced together.
+    scene large;
+    add_random_balls(large, 30000, 8);
+    large.build_acceleration(min_max<float>{ 0.f, 1.f });
+    const std::vector<line> large_rays = random_rays(2000, 9);
+    for (size_t r = 0; r < large_rays.size(); ++r)
+    {
+        check(same_hit(large.hit(large_rays[r], line::hit_interval), brute_force_hit(large, large_rays[r])),
+            "Closest hit in a large scene", r);
+    }
+    const std::vector<line_packet> large_packets = make_packets(large_rays);
+    for (size_t p = 0; p < large_packets.size(); ++p)
+    {
+        std::array<hit_record_opt, line_packet::size> hits;
+        large.hit(large_packets[p], line::hit_interval, hits);
+        for (uint32_t i = 0; i < large_packets[p].count(); ++i)
+        {
+            check(same_hit(hits[i], brute_force_hit(large, large_packets[p][i])), "Packet closest hit in a large scene",
+                p * line_packet::size + i);
+        }
+    }
+
+    if (failures != 0)
+    {
+        std::cerr << failures << " traversal checks failed." << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
\ No newline at end of file